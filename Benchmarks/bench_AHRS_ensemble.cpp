@@ -0,0 +1,161 @@
+/***********************************************************************//**
+ * @file		bench_AHRS_ensemble.cpp
+ * @brief		AHRS_ensemble against AHRS_type on a synthetic flight
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "AHRS.h"
+#include "AHRS_ensemble.h"
+#include "GNSS.h"
+#include "flight_generator.h"
+#include "replay_configuration.h"
+#include <stdio.h>
+#include <time.h>
+
+#define ENSEMBLE_SIZE 8
+#define FLIGHT_DURATION 1800.0f //!< seconds
+#define ATTITUDE_TOLERANCE 0.01f //!< degrees, room for a different float evaluation order
+
+template class AHRS_ensemble< ENSEMBLE_SIZE>; // compile all of it
+
+static double now( void)
+{
+  struct timespec t;
+  clock_gettime( CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+//! largest difference of roll, nick or yaw, wrapped, degrees
+static float euler_difference( const eulerangle<float> & a, const eulerangle<float> & b)
+{
+  float difference[3] = { a.r - b.r, a.n - b.n, a.y - b.y };
+  float maximum = 0.0f;
+  for( unsigned k = 0; k < 3; ++k)
+    {
+      float d = difference[k];
+      if( d > M_PI_F)
+	d -= 2.0f * M_PI_F;
+      if( d < -M_PI_F)
+	d += 2.0f * M_PI_F;
+      if( abs( d) > maximum)
+	maximum = abs( d);
+    }
+  return maximum * 180.0f / M_PI_F;
+}
+
+typedef struct
+{
+  float max_difference;	//!< degrees, any instance, any sample
+  double single_ns;	//!< per sample, one AHRS_type
+  double ensemble_ns;	//!< per sample, all instances
+  size_t samples;
+} comparison_t;
+
+/**
+ * @brief one flight through AHRS_type and all ensemble instances with the default gains
+ *
+ * Magnetic auto-calibration is not part of the ensemble,
+ * it is switched off for AHRS_type here.
+ */
+template< class heading_aiding, class circling_aiding>
+static comparison_t compare( bool D_GNSS)
+{
+  flight_configuration_t configuration;
+  configuration.set( MAG_AUTO_CALIB, 0.0f);
+  configuration_scope_t scope( configuration);
+
+  flight_generator_parameters_t parameters = default_flight_generator_parameters();
+  parameters.D_GNSS = D_GNSS;
+  flight_generator_t generator( parameters, flight_generator_t::cross_country_flight( FLIGHT_DURATION, false));
+
+  AHRS_type single( 0.01f);
+  AHRS_ensemble< ENSEMBLE_SIZE> ensemble( 0.01f);
+  single.update_magnetic_induction_data( parameters.declination, parameters.inclination);
+  ensemble.update_magnetic_induction_data( parameters.declination, parameters.inclination);
+
+  comparison_t result = { 0.0f, 0.0, 0.0, 0 };
+  double single_time = 0.0, ensemble_time = 0.0;
+  const observations_type * block;
+  size_t count;
+  while( ( count = generator.next_block( block)) != 0)
+    for( size_t i = 0; i < count; ++i)
+      {
+	const measurement_data_t & m = block[i].m;
+	const coordinates_t & c = block[i].c;
+	bool heading_valid = c.sat_fix_type == (SAT_FIX | SAT_HEADING);
+
+	if( result.samples == 0)
+	  {
+	    single.attitude_setup( m.acc, m.mag);
+	    ensemble.attitude_setup( m.acc, m.mag);
+	  }
+
+	double start = now();
+	single.update< heading_aiding, circling_aiding>( m.gyro, m.acc, m.mag, c.acceleration, c.relPosHeading, heading_valid);
+	double middle = now();
+	ensemble.template update< heading_aiding, circling_aiding>( m.gyro, m.acc, m.mag, c.acceleration, c.relPosHeading, heading_valid);
+	double end = now();
+	single_time += middle - start;
+	ensemble_time += end - middle;
+
+	for( int instance = 0; instance < ENSEMBLE_SIZE; ++instance)
+	  {
+	    float difference = euler_difference( single.get_euler(), ensemble.get_euler( instance));
+	    if( difference > result.max_difference)
+	      result.max_difference = difference;
+	  }
+	++result.samples;
+      }
+
+  result.single_ns = 1e9 * single_time / result.samples;
+  result.ensemble_ns = 1e9 * ensemble_time / result.samples;
+  return result;
+}
+
+static bool report( const char * name, const comparison_t & result, bool last)
+{
+  bool fail = ! ( result.max_difference <= ATTITUDE_TOLERANCE);
+  printf( "  \"%s\": {\"samples\": %zu, \"max_attitude_difference_deg\": %.5f, "
+	  "\"single_ns\": %.0f, \"ensemble_ns_per_instance\": %.0f, \"result\": \"%s\"}%s\n",
+	  name, result.samples, result.max_difference,
+	  result.single_ns, result.ensemble_ns / ENSEMBLE_SIZE, fail ? "FAIL" : "OK", last ? "" : ",");
+  return fail;
+}
+
+/**
+ * @brief check every ensemble instance against AHRS_type, compare the cost per instance
+ *
+ * All instances use the default gains, so each one must follow AHRS_type
+ * within ATTITUDE_TOLERANCE. JSON output, exit code 1 on any failure.
+ */
+int main( void)
+{
+  printf( "{\n");
+  printf( "  \"instances\": %d,\n", ENSEMBLE_SIZE);
+  bool fail = false;
+  fail |= report( "compass", compare< compass_aiding, default_circling_aiding>( false), false);
+  fail |= report( "compass_cross_acc_circling", compare< compass_aiding, cross_acc_circling>( false), false);
+  fail |= report( "D_GNSS", compare< D_GNSS_aiding, default_circling_aiding>( true), false);
+  fail |= report( "D_GNSS_cross_acc_circling", compare< D_GNSS_aiding, cross_acc_circling>( true), true);
+  printf( "}\n");
+  return fail ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+/***********************************************************************//**
+ * @file		bench_EEPROM_transaction.cpp
+ * @brief		flash writes and power loss behaviour of EEPROM transactions
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "persistent_data.h"
+#include "EEPROM_transaction.h"
+#include <stdio.h>
+
+#define EMULATED_SIZE (EEPROM_SELECTOR + 1)
+
+/**
+ * @brief host model of the emulated EEPROM
+ *
+ * Like the ST EEPROM emulation it skips nothing by itself,
+ * every write_variable() call is one flash program operation.
+ * After power_fail_after() further writes all writes are lost.
+ */
+class emulated_EEPROM_t
+{
+public:
+  emulated_EEPROM_t( void)
+  : writes( 0),
+    writes_left( -1)
+  {
+    for( unsigned i = 0; i < EMULATED_SIZE; ++i)
+      present[i] = false;
+  }
+
+  bool read_variable( unsigned address, float &value) const
+  {
+    if( ! present[address])
+      return true;
+    value = data[address];
+    return false;
+  }
+
+  bool write_variable( unsigned address, float value)
+  {
+    if( writes_left == 0)
+      return true; // power is gone
+    if( writes_left > 0)
+      --writes_left;
+    data[address] = value;
+    present[address] = true;
+    ++writes;
+    return false;
+  }
+
+  //! write with the compare-before-write of persistent_data.cpp
+  bool update_variable( unsigned address, float value)
+  {
+    float old_value;
+    if( read_variable( address, old_value) || ( old_value != value))
+      return write_variable( address, value);
+    return false;
+  }
+
+  //! lose a variable, like a parameter never written
+  void erase_variable( unsigned address)
+  {
+    present[address] = false;
+  }
+
+  void power_fail_after( int count)
+  {
+    writes_left = count;
+  }
+
+  unsigned writes;
+
+private:
+  float data[EMULATED_SIZE];
+  bool present[EMULATED_SIZE];
+  int writes_left; //!< negative: power never fails
+};
+
+static emulated_EEPROM_t EEPROM;
+
+// persistent data interface on top of the model, see persistent_data.cpp for the target
+
+bool write_EEPROM_slot( EEPROM_PARAMETER_ID id, float value, bool slot_B)
+{
+  return EEPROM.update_variable( EEPROM_slot_address( id, slot_B), value);
+}
+
+bool copy_EEPROM_slot( EEPROM_PARAMETER_ID id, bool to_slot_B, float value_if_missing)
+{
+  float value;
+  if( EEPROM.read_variable( EEPROM_slot_address( id, ! to_slot_B), value))
+    value = value_if_missing;
+  return EEPROM.update_variable( EEPROM_slot_address( id, to_slot_B), value);
+}
+
+bool write_EEPROM_selector( uint16_t selector)
+{
+  return EEPROM.update_variable( EEPROM_SELECTOR, selector);
+}
+
+uint16_t read_EEPROM_selector( void)
+{
+  float selector;
+  if( EEPROM.read_variable( EEPROM_SELECTOR, selector))
+    return 0;
+  return (uint16_t)selector;
+}
+
+bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value)
+{
+  return write_EEPROM_slot( id, value, EEPROM_uses_slot_B( read_EEPROM_selector(), id));
+}
+
+bool read_EEPROM_value( EEPROM_PARAMETER_ID id, float &value)
+{
+  return EEPROM.read_variable( EEPROM_slot_address( id, EEPROM_uses_slot_B( read_EEPROM_selector(), id)), value);
+}
+
+bool lock_EEPROM( bool)
+{
+  return false;
+}
+
+#define CALIBRATION_VALUES 7 //!< as written by compass_calibration_t::write_into_EEPROM()
+
+static const EEPROM_PARAMETER_ID CALIBRATION_ID[CALIBRATION_VALUES] =
+    { MAG_X_OFF, MAG_X_SCALE, MAG_Y_OFF, MAG_Y_SCALE, MAG_Z_OFF, MAG_Z_SCALE, MAG_STD_DEVIATION };
+
+static bool commit_calibration( float generation)
+{
+  EEPROM_transaction_t transaction;
+  for( unsigned i = 0; i < CALIBRATION_VALUES; ++i)
+    transaction.stage( CALIBRATION_ID[i], generation + 0.01f * i);
+  return transaction.commit();
+}
+
+//! @return calibration generation found in the EEPROM, negative if mixed up
+static float calibration_generation( void)
+{
+  float generation = -1.0f;
+  for( unsigned i = 0; i < CALIBRATION_VALUES; ++i)
+    {
+      float value;
+      if( read_EEPROM_value( CALIBRATION_ID[i], value))
+	return -1.0f;
+      if( i == 0)
+	generation = value;
+      else if( value != generation + 0.01f * i)
+	return -1.0f;
+    }
+  return generation;
+}
+
+//! all parameters outside of the calibration must keep their value
+static bool others_unchanged( void)
+{
+  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < PERSISTENT_DATA + PERSISTENT_DATA_ENTRIES; ++parameter)
+    {
+      bool is_calibration = false;
+      for( unsigned i = 0; i < CALIBRATION_VALUES; ++i)
+	if( CALIBRATION_ID[i] == parameter->id)
+	  is_calibration = true;
+      float value;
+      if( ! is_calibration && ( read_EEPROM_value( parameter->id, value) || ( value != parameter->default_value)))
+	return false;
+    }
+  return true;
+}
+
+/**
+ * @brief count flash writes per calibration commit and cut the power at every write
+ *
+ * After each simulated power loss either the old or the new calibration
+ * must be found completely, a missing parameter must come back with its default.
+ * JSON output, exit code 1 on any failure.
+ */
+int main( void)
+{
+  ensure_EEPROM_parameter_integrity();
+  unsigned initial_writes = EEPROM.writes;
+
+  bool fail = commit_calibration( 1.0f) || ( calibration_generation() != 1.0f);
+
+  unsigned before = EEPROM.writes;
+  fail |= commit_calibration( 2.0f) || ( calibration_generation() != 2.0f);
+  unsigned commit_writes = EEPROM.writes - before;
+
+  unsigned power_loss_cases = 0, power_loss_failures = 0;
+  const emulated_EEPROM_t committed = EEPROM;
+  for( unsigned cut = 0; cut <= commit_writes; ++cut)
+    {
+      EEPROM = committed;
+      EEPROM.power_fail_after( cut);
+      bool error = commit_calibration( 3.0f);
+      EEPROM.power_fail_after( -1); // next boot
+
+      float generation = calibration_generation();
+      bool expected = error ? generation == 2.0f : generation == 3.0f;
+      ++power_loss_cases;
+      if( ! expected || ! others_unchanged())
+	++power_loss_failures;
+
+      // the next commit after the power loss must succeed again
+      if( commit_calibration( 4.0f) || ( calibration_generation() != 4.0f) || ! others_unchanged())
+	++power_loss_failures;
+    }
+  fail |= power_loss_failures != 0;
+
+  // a parameter missing in its slot, the other slot left over from an interrupted commit:
+  // the next commit must not take the left-over value
+  EEPROM = committed;
+  bool slot_B = EEPROM_uses_slot_B( read_EEPROM_selector(), MAG_AUTO_CALIB);
+  EEPROM.erase_variable( EEPROM_slot_address( MAG_AUTO_CALIB, slot_B));
+  EEPROM.write_variable( EEPROM_slot_address( MAG_AUTO_CALIB, ! slot_B), 7.0f);
+  bool stale_value_taken = commit_calibration( 3.0f) || ! others_unchanged();
+  fail |= stale_value_taken;
+
+  printf( "{\n");
+  printf( "  \"parameters\": %u,\n", PERSISTENT_DATA_ENTRIES);
+  printf( "  \"virtual_addresses\": %u,\n", EEPROM_VIRTUAL_ADDRESS_COUNT);
+  printf( "  \"initialization_writes\": %u,\n", initial_writes);
+  printf( "  \"calibration_commit_writes\": %u,\n", commit_writes);
+  printf( "  \"power_loss_cases\": %u,\n", power_loss_cases);
+  printf( "  \"power_loss_failures\": %u,\n", power_loss_failures);
+  printf( "  \"stale_slot_taken\": %s,\n", stale_value_taken ? "true" : "false");
+  printf( "  \"result\": \"%s\"\n", fail ? "FAIL" : "OK");
+  printf( "}\n");
+  return fail ? 1 : 0;
+}
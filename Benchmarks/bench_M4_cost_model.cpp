@@ -0,0 +1,192 @@
+/***********************************************************************//**
+ * @file		bench_M4_cost_model.cpp
+ * @brief		Cortex-M4F cycle model of the linear least square fit variants
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "Linear_Least_Square_Fit.h"
+#include <stdio.h>
+
+/*
+ * The host timing of larus_bench says nothing about the target:
+ * x86 has a fast 64 bit multiply and a slow dependent division,
+ * the M4 has no 64 bit conversions in hardware but a 14 cycle VDIV.
+ * Here the fit variants run on counting scalar types,
+ * every operation is charged with its Cortex-M4F cycle count.
+ * Instruction timing from the Cortex-M4 TRM, library calls
+ * counted along their libgcc code path.
+ * Not modelled: register spills, pipeline interlocks, flash wait states,
+ * and the compiler sharing repeated int64 to float conversions in evaluate().
+ */
+
+enum M4_operation
+{
+  FLOAT_ADD, FLOAT_MUL, FLOAT_DIV, FLOAT_COMPARE, UNSIGNED_TO_FLOAT,
+  FLOAT_TO_INT64, INT64_TO_FLOAT, INT64_ADD, INT64_MUL,
+  STATE_WORD,
+  M4_OPERATIONS
+};
+
+typedef struct
+{
+  const char * name;
+  unsigned cycles;
+  const char * instructions;
+} M4_cost_t;
+
+static const M4_cost_t M4_COST[M4_OPERATIONS] =
+{
+    { "float_add",		1,  "VADD.F32 / VSUB.F32"},
+    { "float_mul",		1,  "VMUL.F32"},
+    { "float_div",		14, "VDIV.F32"},
+    { "float_compare",		2,  "VCMP.F32 + VMRS"},
+    { "unsigned_to_float",	2,  "VMOV + VCVT.F32.U32"},
+    { "float_to_int64",		190, "__aeabi_f2lz = __fixsfdi, libgcc2.c via soft double: f2d, 2 dmul, dsub, 2 d2uiz, ui2d"},
+    { "int64_to_float",		25, "__aeabi_l2f, ieee754-sf.S: normalize, round"},
+    { "int64_add",		2,  "ADDS + ADC"},
+    { "int64_mul",		5,  "UMULL + 2 MLA, inline"},
+    { "state_word",		1,  "LDM / STM, VLDM / VSTM per word"},
+};
+
+static unsigned long operations[M4_OPERATIONS];
+
+//! float with every operation counted
+class M4_float
+{
+public:
+  M4_float( void) : value( 0.0f) {}
+  M4_float( float v) : value( v) {} //!< constants and arguments, free
+  M4_float( unsigned v) : value( (float)v) { ++operations[UNSIGNED_TO_FLOAT]; }
+  float get( void) const { return value; }
+
+  M4_float & operator += ( const M4_float & r) { return *this = *this + r; }
+
+  friend M4_float operator + ( const M4_float & l, const M4_float & r) { ++operations[FLOAT_ADD]; return l.value + r.value; }
+  friend M4_float operator - ( const M4_float & l, const M4_float & r) { ++operations[FLOAT_ADD]; return l.value - r.value; }
+  friend M4_float operator * ( const M4_float & l, const M4_float & r) { ++operations[FLOAT_MUL]; return l.value * r.value; }
+  friend M4_float operator / ( const M4_float & l, const M4_float & r) { ++operations[FLOAT_DIV]; return l.value / r.value; }
+  friend bool operator > ( const M4_float & l, const M4_float & r) { ++operations[FLOAT_COMPARE]; return l.value > r.value; }
+private:
+  float value;
+};
+
+//! int64_t with every operation counted, mixing with float gives float like in C
+class M4_int64
+{
+public:
+  M4_int64( float v) : value( (int64_t)v) { ++operations[FLOAT_TO_INT64]; }
+  operator M4_float( void) const { ++operations[INT64_TO_FLOAT]; return M4_float( (float)value); }
+
+  M4_int64 & operator ++ ( void) { ++operations[INT64_ADD]; ++value; return *this; }
+  M4_int64 & operator += ( const M4_int64 & r) { ++operations[INT64_ADD]; value += r.value; return *this; }
+  M4_int64 & operator = ( float v) { return *this = M4_int64( v); }
+
+  friend M4_int64 operator * ( const M4_int64 & l, const M4_int64 & r) { ++operations[INT64_MUL]; return M4_int64( l.value * r.value, 0); }
+  friend M4_float operator - ( const M4_int64 & l, float r) { return M4_float( l) - M4_float( r); }
+private:
+  M4_int64( int64_t v, int) : value( v) {} //!< integer result, no conversion
+  int64_t value;
+};
+
+#define SAMPLES 10000 //!< like a magnetic calibration over a few circles
+
+//! induction-like test data, sensor units scaled by MAG_SCALE
+static float sample( unsigned i, unsigned channel)
+{
+  static uint32_t seed = 12345;
+  seed = seed * 1664525 + 1013904223;
+  float noise = (float)(seed >> 8) / (float)(1 << 24) - 0.5f;
+  float phase = 0.01f * (float)i;
+  return channel == 0 ? 20000.0f * SIN( phase) : 500.0f + 20400.0f * SIN( phase) + 100.0f * noise;
+}
+
+static void clear_operations( void)
+{
+  for( unsigned k = 0; k < M4_OPERATIONS; ++k)
+    operations[k] = 0;
+}
+
+//! print the average operations per call, @return modelled cycles per call
+static float report( const char * name, unsigned long calls, unsigned state_words)
+{
+  operations[STATE_WORD] = 2ul * state_words * calls; // load and store the whole state
+  float cycles = 0.0f;
+  printf( "  \"%s\": {", name);
+  for( unsigned k = 0; k < M4_OPERATIONS; ++k)
+    {
+      float per_call = (float)operations[k] / (float)calls;
+      cycles += per_call * (float)M4_COST[k].cycles;
+      if( operations[k] != 0)
+	printf( "\"%s\": %.1f, ", M4_COST[k].name, per_call);
+    }
+  printf( "\"M4_cycles\": %.0f},\n", cycles);
+  return cycles;
+}
+
+/**
+ * @brief modelled M4 cycles per add_value() and evaluate() as JSON
+ *
+ * Compares the default magnetic calibration statistics, int64 sums with float evaluation,
+ * with the centered float version, see USE_CENTERED_FLOAT_STATISTICS.
+ */
+int main( void)
+{
+  const unsigned int64_state_words = sizeof( linear_least_square_fit< int64_t, float>) / 4;
+  const unsigned centered_state_words = sizeof( linear_least_square_fit< centered_float, float>) / 4;
+
+  printf( "{\n");
+  printf( "  \"cycles\": {");
+  for( unsigned k = 0; k < M4_OPERATIONS; ++k)
+    printf( "\"%s\": %u%s", M4_COST[k].name, M4_COST[k].cycles, k + 1 < M4_OPERATIONS ? ", " : "},\n");
+
+  linear_least_square_fit< M4_int64, M4_float> int64_fit;
+  linear_least_square_fit< centered< M4_float>, M4_float> centered_fit;
+  linear_least_square_result< M4_float> result;
+
+  clear_operations();
+  for( unsigned i = 0; i < SAMPLES; ++i)
+    int64_fit.add_value( sample( i, 0), sample( i, 1));
+  float int64_add = report( "add_value_int64", SAMPLES, int64_state_words);
+
+  clear_operations();
+  for( unsigned i = 0; i < SAMPLES; ++i)
+    centered_fit.add_value( sample( i, 0), sample( i, 1));
+  float centered_add = report( "add_value_centered_float", SAMPLES, centered_state_words);
+
+  clear_operations();
+  int64_fit.evaluate( result);
+  float int64_evaluate = report( "evaluate_int64", 1, int64_state_words / 2);
+
+  clear_operations();
+  centered_fit.evaluate( result);
+  float centered_evaluate = report( "evaluate_centered_float", 1, centered_state_words / 2);
+
+  // the library conversion dominates the int64 path, at this cost both are equal
+  float conversions = 2.0f;
+  float break_even = M4_COST[FLOAT_TO_INT64].cycles - ( int64_add - centered_add) / conversions;
+
+  printf( "  \"add_value_ratio\": %.2f,\n", centered_add / int64_add);
+  printf( "  \"add_value_break_even_float_to_int64_cycles\": %.0f,\n", break_even);
+  printf( "  \"evaluate_ratio\": %.2f\n", centered_evaluate / int64_evaluate);
+  printf( "}\n");
+  return 0;
+}
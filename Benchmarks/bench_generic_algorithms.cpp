@@ -0,0 +1,447 @@
+/***********************************************************************//**
+ * @file		bench_generic_algorithms.cpp
+ * @brief		micro-benchmarks for the generic algorithms and the Kalman filters
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "bench_harness.h"
+#include "pt2.h"
+#include "pt2_fixed.h"
+#include "quaternion.h"
+#include "float3vector.h"
+#include "float3matrix.h"
+#include "quaternion_batch.h"
+#include "Linear_Least_Square_Fit.h"
+#include "soaring_flight_averager.h"
+#include "KalmanVario.h"
+#include "KalmanVario_PVA.h"
+#include "Kalman_V_A_observer.h"
+#include "Kalman_V_A_Aoff_observer.h"
+#include "variometer.h"
+#include "earth_induction_model.h"
+#include "earth_induction_grid.h"
+
+#define INPUT_SIZE 256 //!< power of two, inputs are cycled through
+
+//! deterministic input data, so the compiler can not fold the computation
+class bench_input_t
+{
+public:
+  bench_input_t( void)
+  {
+    uint32_t seed = 12345;
+    for( unsigned i = 0; i < INPUT_SIZE; ++i)
+      {
+	seed = seed * 1664525 + 1013904223; // LCG, good enough here
+	value[i] = (float)(seed >> 8) / (float)(1 << 24) - 0.5f;
+	for( unsigned k = 0; k < 3; ++k)
+	  {
+	    seed = seed * 1664525 + 1013904223;
+	    vector3[i][k] = (float)(seed >> 8) / (float)(1 << 24) - 0.5f;
+	  }
+	seed = seed * 1664525 + 1013904223; // europe and surroundings, several model areas
+	latitude[i]  = 30.0 + 40.0 * (double)(seed >> 8) / (double)(1 << 24);
+	seed = seed * 1664525 + 1013904223;
+	longitude[i] = -20.0 + 60.0 * (double)(seed >> 8) / (double)(1 << 24);
+      }
+  }
+  float value[INPUT_SIZE];
+  float3vector vector3[INPUT_SIZE];
+  double latitude[INPUT_SIZE];
+  double longitude[INPUT_SIZE];
+};
+
+static const bench_input_t input;
+
+#define TRACK_SIZE 4096 //!< GNSS fixes, power of two
+
+//! glider track at 10 Hz, circling and gliding across a grid corner
+class bench_track_t
+{
+public:
+  bench_track_t( void)
+  {
+    double north = 44.95, east = 9.95, heading = 0.8;
+    for( unsigned i = 0; i < TRACK_SIZE; ++i)
+      {
+	latitude[i] = north;
+	longitude[i] = east;
+	if( ( i / 400) % 2) // 20 degrees per second for 40 s, then 40 s straight on
+	  heading += 0.035;
+	north += 2.7e-5 * COS( heading); // 30 m/s
+	east  += 3.8e-5 * SIN( heading);
+      }
+  }
+  double latitude[TRACK_SIZE];
+  double longitude[TRACK_SIZE];
+};
+
+static const bench_track_t track;
+
+BENCHMARK( pt2_float_respond)
+{
+  pt2<float, float> filter( 0.01f);
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    result += filter.respond( input.value[i % INPUT_SIZE]);
+  do_not_optimize( result);
+}
+
+BENCHMARK( pt2_float3vector_respond)
+{
+  pt2<float3vector, float> filter( 0.01f);
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    filter.respond( input.vector3[i % INPUT_SIZE]);
+  float3vector result = filter.get_output();
+  do_not_optimize( result);
+}
+
+BENCHMARK( pt2_q_format_respond)
+{
+  pt2< q_format<16>, float> filter( pt2_fixed_design( 0.01));
+  int32_t result = 0;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    result += filter.respond( q_format<16>::from_raw( (int32_t)( input.value[i % INPUT_SIZE] * 65536.0f))).raw();
+  do_not_optimize( result);
+}
+
+BENCHMARK( quaternion_rotate_normalize)
+{
+  quaternion<float> q;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      const float3vector & w = input.vector3[i % INPUT_SIZE];
+      q.rotate( w[0] * 0.005f, w[1] * 0.005f, w[2] * 0.005f);
+      q.normalize();
+    }
+  do_not_optimize( q);
+}
+
+BENCHMARK( quaternion_get_rotation_matrix)
+{
+  quaternion<float> q;
+  q.from_euler( 0.1f, 0.2f, 0.3f);
+  float3matrix m;
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      q[1] = input.value[i % INPUT_SIZE];
+      q.get_rotation_matrix( m);
+      do_not_optimize( m);
+      result += m.e[2][1];
+    }
+  do_not_optimize( result);
+}
+
+BENCHMARK( matrix_times_vector)
+{
+  quaternion<float> q;
+  q.from_euler( 0.1f, 0.2f, 0.3f);
+  float3matrix m;
+  q.get_rotation_matrix( m);
+  float3vector sum;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    sum += m * input.vector3[i % INPUT_SIZE];
+  do_not_optimize( sum);
+}
+
+BENCHMARK( matrix_reverse_map)
+{
+  quaternion<float> q;
+  q.from_euler( 0.1f, 0.2f, 0.3f);
+  float3matrix m;
+  q.get_rotation_matrix( m);
+  float3vector sum;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    sum += m.reverse_map( input.vector3[i % INPUT_SIZE]);
+  do_not_optimize( sum);
+}
+
+#define BATCH_SIZE 8 //!< one AVX register
+
+BENCHMARK( quaternion_batch_rotate) // time per quaternion
+{
+  quaternion_batch<BATCH_SIZE> q;
+  float3vector_batch<BATCH_SIZE> w;
+  for( int k = 0; k < BATCH_SIZE; ++k)
+    {
+      float3vector rotation;
+      for( int axis = 0; axis < 3; ++axis)
+	rotation[axis] = input.vector3[k][axis] * 0.005f;
+      w.set( k, rotation);
+    }
+  for( uint64_t i = 0; i < state.iterations; i += BATCH_SIZE)
+    q.rotate( w);
+  do_not_optimize( q);
+}
+
+BENCHMARK( quaternion_batch_get_rotation_matrix) // time per quaternion
+{
+  quaternion_batch<BATCH_SIZE> q;
+  float3matrix_batch<BATCH_SIZE> m;
+  for( uint64_t i = 0; i < state.iterations; i += BATCH_SIZE)
+    {
+      q.e[1][i / BATCH_SIZE % BATCH_SIZE] = input.value[i % INPUT_SIZE];
+      q.get_rotation_matrix( m);
+      do_not_optimize( m);
+    }
+}
+
+BENCHMARK( matrix_batch_times_vector) // time per vector
+{
+  quaternion_batch<BATCH_SIZE> q;
+  float3matrix_batch<BATCH_SIZE> m;
+  q.get_rotation_matrix( m);
+  float3vector_batch<BATCH_SIZE> v;
+  for( int k = 0; k < BATCH_SIZE; ++k)
+    v.set( k, input.vector3[k]);
+  float3vector_batch<BATCH_SIZE> sum;
+  for( uint64_t i = 0; i < state.iterations; i += BATCH_SIZE)
+    sum += m * v;
+  do_not_optimize( sum);
+}
+
+BENCHMARK( least_square_fit_add_value_int64)
+{
+  linear_least_square_fit<int64_t, float> fit;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    fit.add_value( (int64_t)(input.value[i % INPUT_SIZE] * 10000.0f), (int64_t)(input.value[(i + 1) % INPUT_SIZE] * 10000.0f));
+  do_not_optimize( fit);
+}
+
+BENCHMARK( least_square_fit_add_value_double)
+{
+  linear_least_square_fit<double, double> fit;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    fit.add_value( input.value[i % INPUT_SIZE], input.value[(i + 1) % INPUT_SIZE]);
+  do_not_optimize( fit);
+}
+
+BENCHMARK( least_square_fit_add_value_centered_float)
+{
+  linear_least_square_fit<centered_float, float> fit;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    fit.add_value( input.value[i % INPUT_SIZE] * 10000.0f, input.value[(i + 1) % INPUT_SIZE] * 10000.0f);
+  do_not_optimize( fit);
+}
+
+BENCHMARK( least_square_fit_evaluate_int64)
+{
+  linear_least_square_fit<int64_t, float> fit;
+  for( unsigned i = 0; i < INPUT_SIZE; ++i)
+    fit.add_value( i, (int64_t)(input.value[i] * 10000.0f));
+  linear_least_square_result<float> result;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      do_not_optimize( fit); // force evaluation in every iteration
+      fit.evaluate( result);
+      do_not_optimize( result);
+    }
+}
+
+BENCHMARK( least_square_fit_evaluate_double)
+{
+  linear_least_square_fit<double, double> fit;
+  for( unsigned i = 0; i < INPUT_SIZE; ++i)
+    fit.add_value( i, input.value[i]);
+  linear_least_square_result<double> result;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      do_not_optimize( fit); // force evaluation in every iteration
+      fit.evaluate( result);
+      do_not_optimize( result);
+    }
+}
+
+BENCHMARK( least_square_fit_evaluate_centered_float)
+{
+  linear_least_square_fit<centered_float, float> fit;
+  for( unsigned i = 0; i < INPUT_SIZE; ++i)
+    fit.add_value( i, input.value[i] * 10000.0f);
+  linear_least_square_result<float> result;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      do_not_optimize( fit); // force evaluation in every iteration
+      fit.evaluate( result);
+      do_not_optimize( result);
+    }
+}
+
+BENCHMARK( soaring_flight_averager_update_circling)
+{
+  soaring_flight_averager<float> averager( 0.01f);
+  float heading = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      heading += 0.02f; // about 30 s per circle at 100 Hz
+      if( heading > M_PI_F)
+	heading -= 2.0f * M_PI_F;
+      averager.update( input.value[i % INPUT_SIZE], heading, CIRCLING);
+    }
+  float result = averager.get_output();
+  do_not_optimize( result);
+}
+
+BENCHMARK( soaring_flight_averager_update_float3vector)
+{
+  soaring_flight_averager<float3vector> averager( 0.01f);
+  float heading = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      heading += 0.02f;
+      if( heading > M_PI_F)
+	heading -= 2.0f * M_PI_F;
+      averager.update( input.vector3[i % INPUT_SIZE], heading, CIRCLING);
+    }
+  float3vector result = averager.get_output();
+  do_not_optimize( result);
+}
+
+BENCHMARK( soaring_flight_averager_update_64_sectors)
+{
+  soaring_flight_averager<float, false, true, 64> averager( 0.01f);
+  float heading = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      heading += 0.02f;
+      if( heading > M_PI_F)
+	heading -= 2.0f * M_PI_F;
+      averager.update( input.value[i % INPUT_SIZE], heading, CIRCLING);
+    }
+  float result = averager.get_output();
+  do_not_optimize( result);
+}
+
+BENCHMARK( KalmanVario_update)
+{
+  KalmanVario_t filter;
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    result += filter.update( input.value[i % INPUT_SIZE], input.value[(i + 7) % INPUT_SIZE]);
+  do_not_optimize( result);
+}
+
+BENCHMARK( KalmanVario_PVA_update)
+{
+  KalmanVario_PVA_t filter;
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    result += filter.update( input.value[i % INPUT_SIZE], input.value[(i + 3) % INPUT_SIZE], input.value[(i + 7) % INPUT_SIZE]);
+  do_not_optimize( result);
+}
+
+BENCHMARK( Kalman_V_A_observer_update)
+{
+  Kalman_V_A_observer_t filter;
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    result += filter.update( input.value[i % INPUT_SIZE], input.value[(i + 7) % INPUT_SIZE]);
+  do_not_optimize( result);
+}
+
+BENCHMARK( Kalman_V_A_Aoff_observer_update)
+{
+  Kalman_V_A_Aoff_observer_t filter;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    filter.update( input.value[i % INPUT_SIZE], input.value[(i + 7) % INPUT_SIZE]);
+  float result = filter.get_x( Kalman_V_A_Aoff_observer_t::VELOCITY);
+  do_not_optimize( result);
+}
+
+//! the four filters above, in the variometer bank
+BENCHMARK( variometer_kalman_bank_update)
+{
+  variometer_kalman_bank_t bank;
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      const float y[variometer_kalman_bank_t::L][variometer_kalman_bank_t::LANES] =
+	{
+	  { input.value[i % INPUT_SIZE],       input.value[(i + 1) % INPUT_SIZE], input.value[(i + 2) % INPUT_SIZE], input.value[(i + 4) % INPUT_SIZE] },
+	  { input.value[(i + 7) % INPUT_SIZE], input.value[(i + 3) % INPUT_SIZE], input.value[(i + 5) % INPUT_SIZE], input.value[(i + 6) % INPUT_SIZE] },
+	  { 0.0f,                              input.value[(i + 7) % INPUT_SIZE], 0.0f,                              0.0f }
+	};
+      bank.update( y);
+      result += bank.get_x( PRESSURE_LANE, KalmanVario_t::VARIO) + bank.get_x( GNSS_LANE, KalmanVario_PVA_t::VARIO);
+    }
+  do_not_optimize( result);
+}
+
+BENCHMARK( earth_induction_model_single)
+{
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      induction_values values = earth_induction_model.get_induction_data_at(
+	  input.latitude[i % INPUT_SIZE], input.longitude[i % INPUT_SIZE]);
+      result += values.declination + values.inclination;
+    }
+  do_not_optimize( result);
+}
+
+BENCHMARK( earth_induction_grid_single)
+{
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      induction_values values = earth_induction_grid.get_induction_data_at(
+	  input.latitude[i % INPUT_SIZE], input.longitude[i % INPUT_SIZE]);
+      result += values.declination + values.inclination;
+    }
+  do_not_optimize( result);
+}
+
+BENCHMARK( earth_induction_grid_batch) // time per position, scattered positions
+{
+  static float declination[INPUT_SIZE];
+  static float inclination[INPUT_SIZE];
+  for( uint64_t i = 0; i < state.iterations; i += INPUT_SIZE)
+    {
+      earth_induction_grid.get_induction_data_at( input.latitude, input.longitude, INPUT_SIZE,
+						  declination, inclination);
+      do_not_optimize( declination);
+    }
+}
+
+BENCHMARK( earth_induction_grid_track_single)
+{
+  float result = 0.0f;
+  for( uint64_t i = 0; i < state.iterations; ++i)
+    {
+      induction_values values = earth_induction_grid.get_induction_data_at(
+	  track.latitude[i % TRACK_SIZE], track.longitude[i % TRACK_SIZE]);
+      result += values.declination + values.inclination;
+    }
+  do_not_optimize( result);
+}
+
+BENCHMARK( earth_induction_grid_track_batch) // time per position
+{
+  static float declination[TRACK_SIZE];
+  static float inclination[TRACK_SIZE];
+  for( uint64_t i = 0; i < state.iterations; i += TRACK_SIZE)
+    {
+      earth_induction_grid.get_induction_data_at( track.latitude, track.longitude, TRACK_SIZE,
+						  declination, inclination);
+      do_not_optimize( declination);
+    }
+}
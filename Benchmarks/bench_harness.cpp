@@ -0,0 +1,221 @@
+/***********************************************************************//**
+ * @file		bench_harness.cpp
+ * @brief		minimal micro-benchmark harness with JSON output
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "bench_harness.h"
+#include "simd_lanes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define REPETITIONS 5 //!< best of this number of runs is reported
+
+struct bench_entry_t
+{
+  const char * name;
+  bench_function_t function;
+};
+
+static std::vector< bench_entry_t> & registry( void)
+{
+  static std::vector< bench_entry_t> benchmarks; // constructed on first use
+  return benchmarks;
+}
+
+bench_registration_t::bench_registration_t( const char * name, bench_function_t function)
+{
+  bench_entry_t entry = { name, function};
+  registry().push_back( entry);
+}
+
+static double now( void)
+{
+  struct timespec t;
+  clock_gettime( CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+//! retired user-space instructions, if the kernel permits
+class instruction_counter_t
+{
+public:
+  instruction_counter_t( void)
+  : fd( -1)
+  {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset( &attr, 0, sizeof( attr));
+    attr.size = sizeof( attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = (int)syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+  ~instruction_counter_t( void)
+  {
+#ifdef __linux__
+    if( fd >= 0)
+      close( fd);
+#endif
+  }
+  bool available( void) const
+  {
+    return fd >= 0;
+  }
+  void start( void)
+  {
+#ifdef __linux__
+    if( fd < 0)
+      return;
+    ioctl( fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl( fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+  uint64_t stop( void)
+  {
+    uint64_t count = 0;
+#ifdef __linux__
+    if( fd < 0)
+      return 0;
+    ioctl( fd, PERF_EVENT_IOC_DISABLE, 0);
+    if( read( fd, &count, sizeof( count)) != sizeof( count))
+      count = 0;
+#endif
+    return count;
+  }
+private:
+  int fd;
+};
+
+/**
+ * @brief run all benchmarks and print the results as JSON
+ *
+ * Options: --filter=substring, --min_time=seconds, --out=file
+ */
+int run_benchmarks( int argc, char ** argv)
+{
+  const char * filter = 0;
+  const char * out_file = 0;
+  double min_time = 0.1;
+
+  for( int i = 1; i < argc; ++i)
+    {
+      if( strncmp( argv[i], "--filter=", 9) == 0)
+	filter = argv[i] + 9;
+      else if( strncmp( argv[i], "--min_time=", 11) == 0)
+	min_time = atof( argv[i] + 11);
+      else if( strncmp( argv[i], "--out=", 6) == 0)
+	out_file = argv[i] + 6;
+      else
+	{
+	  fprintf( stderr, "usage: %s [--filter=substring] [--min_time=seconds] [--out=file]\n", argv[0]);
+	  return 1;
+	}
+    }
+
+  FILE * out = out_file ? fopen( out_file, "w") : stdout;
+  if( out == 0)
+    {
+      perror( out_file);
+      return 1;
+    }
+
+  instruction_counter_t instructions;
+
+  fprintf( out, "{\n  \"context\": {\n");
+  fprintf( out, "    \"compiler\": \"%s\",\n", __VERSION__);
+  fprintf( out, "    \"min_time\": %g,\n", min_time);
+  fprintf( out, "    \"simd_lanes\": %d,\n", SIMD_LANES);
+  fprintf( out, "    \"instruction_counter\": %s\n", instructions.available() ? "true" : "false");
+  fprintf( out, "  },\n  \"benchmarks\": [");
+
+  bool first = true;
+  for( const bench_entry_t & entry : registry())
+    {
+      if( filter && strstr( entry.name, filter) == 0)
+	continue;
+
+      // find an iteration count that runs for at least min_time
+      uint64_t iterations = 1;
+      while( true)
+	{
+	  bench_state_t state( iterations);
+	  double start = now();
+	  entry.function( state);
+	  double elapsed = now() - start;
+	  if( elapsed >= min_time || iterations >= (1ULL << 40))
+	    break;
+	  uint64_t next = elapsed > 1e-6 ? (uint64_t)(iterations * 1.4 * min_time / elapsed) : iterations * 100;
+	  iterations = next > iterations ? next : iterations + 1;
+	}
+
+      double best_ns = 1e30;
+      uint64_t best_instructions = 0;
+      for( unsigned repetition = 0; repetition < REPETITIONS; ++repetition)
+	{
+	  bench_state_t state( iterations);
+	  instructions.start();
+	  double start = now();
+	  entry.function( state);
+	  double elapsed = now() - start;
+	  uint64_t count = instructions.stop();
+	  double ns = 1e9 * elapsed / iterations;
+	  if( ns < best_ns)
+	    {
+	      best_ns = ns;
+	      best_instructions = count;
+	    }
+	}
+
+      fprintf( out, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, ",
+	       first ? "" : ",", entry.name, (unsigned long long)iterations, best_ns);
+      if( instructions.available())
+	fprintf( out, "\"instructions_per_op\": %.2f}", (double)best_instructions / iterations);
+      else
+	fprintf( out, "\"instructions_per_op\": null}");
+      first = false;
+      fflush( out);
+    }
+
+  fprintf( out, "\n  ]\n}\n");
+  if( out != stdout)
+    fclose( out);
+  return 0;
+}
+
+int main( int argc, char ** argv)
+{
+  return run_benchmarks( argc, argv);
+}
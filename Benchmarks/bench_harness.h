@@ -0,0 +1,64 @@
+/***********************************************************************//**
+ * @file		bench_harness.h
+ * @brief		minimal micro-benchmark harness with JSON output
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef BENCH_HARNESS_H_
+#define BENCH_HARNESS_H_
+
+#include <stdint.h>
+
+//! loop control handed to every benchmark function
+class bench_state_t
+{
+public:
+  bench_state_t( uint64_t _iterations)
+  : iterations( _iterations)
+  {}
+  uint64_t iterations; //!< number of operations to execute
+};
+
+typedef void (*bench_function_t)( bench_state_t & state);
+
+//! static registration of one benchmark, see BENCHMARK()
+class bench_registration_t
+{
+public:
+  bench_registration_t( const char * name, bench_function_t function);
+};
+
+//! keep the compiler from optimizing a result away
+template <class value_t> inline void do_not_optimize( value_t & value)
+{
+  asm volatile( "" : "+m"( value) : : "memory");
+}
+
+//! define and register a benchmark: BENCHMARK( name) { for( ... state.iterations ...) }
+#define BENCHMARK( name) \
+  static void name( bench_state_t & state); \
+  static bench_registration_t name ## _registration( #name, name); \
+  static void name( bench_state_t & state)
+
+//! run all registered benchmarks, see bench_harness.cpp for the command line
+int run_benchmarks( int argc, char ** argv);
+
+#endif /* BENCH_HARNESS_H_ */
@@ -0,0 +1,158 @@
+/***********************************************************************//**
+ * @file		bench_organizer_throughput.cpp
+ * @brief		end-to-end throughput of the organizer on a one hour flight
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "organizer.h"
+#include "flight_log_reader.h"
+#include "flight_generator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include <algorithm>
+
+#define SAMPLES_PER_HOUR (100 * 3600)
+
+static double now( void)
+{
+  struct timespec t;
+  clock_gettime( CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static double percentile( std::vector< float> & values, double fraction)
+{
+  if( values.empty())
+    return 0.0;
+  size_t index = (size_t)(fraction * (values.size() - 1));
+  std::nth_element( values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+/**
+ * @brief feed a flight through organizer_t, report timing as JSON
+ *
+ * usage: larus_throughput [recorded flight log]
+ * Without argument a synthetic one hour flight is used.
+ */
+int main( int argc, char ** argv)
+{
+  std::vector< observations_type> synthetic;
+  flight_log_reader_t reader;
+  const observations_type * flight;
+  size_t samples;
+
+  if( argc > 1)
+    {
+      if( reader.open( argv[1]))
+	{
+	  fprintf( stderr, "%s: can not use flight log\n", argv[1]);
+	  return 1;
+	}
+      flight = reader.get_records();
+      samples = reader.get_record_count();
+    }
+  else
+    {
+      flight_generator_t generator( default_flight_generator_parameters(),
+				    flight_generator_t::cross_country_flight( SAMPLES_PER_HOUR / 100, true));
+      synthetic.reserve( generator.get_total_samples());
+      const observations_type * block;
+      size_t block_size;
+      while( (block_size = generator.next_block( block)) != 0)
+	synthetic.insert( synthetic.end(), block, block + block_size);
+      flight = synthetic.data();
+      samples = synthetic.size();
+    }
+
+  std::vector< float> fast_tick_ns;
+  std::vector< float> slow_tick_ns;
+  fast_tick_ns.reserve( samples);
+  slow_tick_ns.reserve( samples / 10 + 1);
+
+  double background_total = 0.0;
+
+  organizer_t organizer;
+  output_data_t output_data{};
+  organizer.initialize_before_measurement();
+  organizer.register_background_task();
+
+  double start = now();
+  for( size_t i = 0; i < samples; ++i)
+    {
+      output_data.m = flight[i].m;
+      output_data.c = flight[i].c;
+
+      if( i == 0)
+	{
+	  organizer.initialize_after_first_measurement( output_data);
+	  organizer.update_magnetic_induction_data( output_data.c.latitude, output_data.c.longitude);
+	}
+
+      double tick_start = now();
+      organizer.on_new_pressure_data( output_data);
+      organizer.update_GNSS_data( output_data.c);
+      organizer.update_every_10ms( output_data);
+      double background_start = now();
+      organizer.process_background_tasks(); // low-priority task on the target
+      double background_end = now();
+      organizer.report_data( output_data);
+      double tick_end = now();
+      fast_tick_ns.push_back( 1e9 * (background_start - tick_start + tick_end - background_end));
+      background_total += 1e9 * (background_end - background_start);
+
+      if( i % 10 == 9)
+	{
+#if WITH_DENSITY_DATA
+	  organizer.set_density_data( output_data.m.outside_air_temperature, output_data.m.outside_air_humidity);
+#endif
+	  organizer.update_every_100ms( output_data);
+	  slow_tick_ns.push_back( 1e9 * (now() - tick_end));
+	}
+    }
+  double elapsed = now() - start;
+
+  double fast_total = 0.0, slow_total = 0.0;
+  for( float t : fast_tick_ns)
+    fast_total += t;
+  for( float t : slow_tick_ns)
+    slow_total += t;
+
+  printf( "{\n");
+  printf( "  \"DEVELOPMENT_ADDITIONS\": %d,\n", DEVELOPMENT_ADDITIONS);
+  printf( "  \"samples\": %zu,\n", samples);
+  printf( "  \"seconds\": %.3f,\n", elapsed);
+  printf( "  \"samples_per_second\": %.0f,\n", samples / elapsed);
+  printf( "  \"realtime_factor\": %.0f,\n", samples * 0.01 / elapsed);
+  printf( "  \"fast_tick_ns\": {\"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f, \"share\": %.3f},\n",
+	  percentile( fast_tick_ns, 0.5), percentile( fast_tick_ns, 0.99), percentile( fast_tick_ns, 1.0),
+	  fast_total / (fast_total + slow_total));
+  printf( "  \"slow_tick_ns\": {\"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f, \"share\": %.3f},\n",
+	  percentile( slow_tick_ns, 0.5), percentile( slow_tick_ns, 0.99), percentile( slow_tick_ns, 1.0),
+	  slow_total / (fast_total + slow_total));
+  printf( "  \"background_ns_per_sample\": %.0f,\n", background_total / samples);
+  printf( "  \"background_overruns\": %u\n", organizer.get_background_overruns());
+  printf( "}\n");
+  return 0;
+}
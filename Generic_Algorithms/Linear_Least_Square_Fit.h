@@ -121,4 +121,129 @@ template<typename sample_type, typename evaluation_type=sample_type>
     sample_type n;
   };
 
+/**
+ * @brief sample type tag: centered statistics in single precision float
+ *
+ * linear_least_square_fit< centered_float, float> keeps the means and the sums
+ * of the deviations from the means (Welford update) instead of raw sums,
+ * so there is no 64 bit integer or double arithmetic and no cancellation
+ * of large raw sums on evaluation.
+ * The residual sum of squares is accumulated from the prediction errors
+ * (recursive least squares), the means and the sums use compensated
+ * (Kahan) summation. One division per sample.
+ * Must not be compiled with -ffast-math, which removes the compensation.
+ * The scalar type is float, the M4 cost model in Benchmarks/bench_M4_cost_model.cpp
+ * uses an operation counting type instead.
+ */
+template<typename scalar> struct centered {};
+typedef centered<float> centered_float;
+
+//! @brief linear least square fit for  y = a + b * x, centered version
+template<typename scalar, typename evaluation_type>
+  class linear_least_square_fit< centered< scalar>, evaluation_type>
+  {
+  public:
+    linear_least_square_fit (void)
+    {
+      reset();
+    }
+    void
+    add_value (const scalar x, const scalar y)
+    {
+      scalar dx = x - mean_x;
+      scalar dy = y - mean_y;
+      scalar previous_n = (scalar)n;
+      ++n;
+      scalar new_n = (scalar)n;
+
+      // 1/n and 1/Qx(new) from one division, n * Qx(new) = n * Qx + (n-1) * dx^2
+      scalar n_Qx = new_n * Qx + previous_n * dx * dx;
+      scalar inv_n;
+      scalar new_inv_Qx;
+      if( n_Qx > ZERO)
+	{
+	  scalar r = ONE / ( new_n * n_Qx);
+	  inv_n = n_Qx * r;
+	  new_inv_Qx = new_n * new_n * r;
+	}
+      else // no spread in x yet
+	{
+	  inv_n = ONE / new_n;
+	  new_inv_Qx = ZERO;
+	}
+      scalar weight = previous_n * inv_n; // (n-1)/n
+
+      // prediction error of the fit so far, zero for the first two samples
+      scalar error = dy - Qxy * inv_Qx * dx;
+      RSS += weight * error * error * Qx * new_inv_Qx;
+
+      compensated_add( mean_x, mean_x_error, dx * inv_n);
+      compensated_add( mean_y, mean_y_error, dy * inv_n);
+      compensated_add( Qx,  Qx_error,  weight * dx * dx);
+      compensated_add( Qxy, Qxy_error, weight * dx * dy);
+      inv_Qx = new_inv_Qx;
+    }
+    void
+    reset (void)
+    {
+      mean_x = mean_y = Qx = Qxy = RSS = inv_Qx = ZERO;
+      mean_x_error = mean_y_error = Qx_error = Qxy_error = ZERO;
+      n = 0;
+    }
+    void
+    evaluate (evaluation_type &a, evaluation_type &b, evaluation_type &variance_a, evaluation_type &variance_b) const
+    {
+      evaluation_type inv_n = (evaluation_type)ONE / n;
+      evaluation_type invQx = (evaluation_type)ONE / Qx;
+
+//      ASSERT( n > 2);
+      evaluation_type Vyx = RSS / (evaluation_type)(n - 2);
+
+      b = Qxy * invQx;
+      a = mean_y - b * mean_x;
+
+      variance_a = Vyx * (inv_n + SQR( mean_x) * invQx);
+      variance_b = Vyx * invQx;
+    }
+    void
+    evaluate (linear_least_square_result<evaluation_type> &r) const
+    {
+      evaluate (r.y_offset, r.slope, r.variance_offset, r.variance_slope);
+    }
+    unsigned
+    get_count (void) const
+    {
+      return n;
+    }
+    scalar get_mean_y( void) const
+    {
+      return mean_y;
+    }
+    scalar get_mean_x( void) const
+    {
+      return mean_x;
+    }
+  private:
+    //! Kahan summation, error keeps the lost low order part
+    static void compensated_add( scalar &sum, scalar &error, scalar value)
+    {
+      scalar corrected = value - error;
+      scalar new_sum = sum + corrected;
+      error = (new_sum - sum) - corrected;
+      sum = new_sum;
+    }
+
+    scalar mean_x;
+    scalar mean_y;
+    scalar Qx;			//!< sum of squared deviations of x from mean_x
+    scalar Qxy;			//!< sum of the products of the deviations
+    scalar RSS;			//!< residual sum of squares
+    scalar inv_Qx;		//!< 1 / Qx, 0 while there is no spread in x
+    scalar mean_x_error;	//!< compensation terms, see compensated_add()
+    scalar mean_y_error;
+    scalar Qx_error;
+    scalar Qxy_error;
+    unsigned n;
+  };
+
 #endif /* LINEAR_LEAST_SQUARE_FIT_H_ */
@@ -0,0 +1,114 @@
+/***********************************************************************//**
+ * @file		coning_integrator.h
+ * @brief		high-rate gyro integration with coning compensation
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef CONING_INTEGRATOR_H_
+#define CONING_INTEGRATOR_H_
+
+#include "embedded_math.h"
+#include "float3vector.h"
+#include "float3matrix.h"
+
+/**
+ * @brief accumulate gyro samples at the native IMU rate
+ *
+ * Sums the angle increments (alpha) and the coning correction (beta)
+ * of the present update interval, recursive formula after P.G. Savage:
+ * beta += 1/2 * ( alpha + 1/6 * last increment) x increment.
+ * alpha + beta is the rotation vector of the complete interval,
+ * to be used with quaternion::rotate_exact().
+ */
+class coning_integrator_t
+{
+public:
+  coning_integrator_t( void)
+  : alpha(),
+    beta(),
+    last_increment(),
+    interval( ZERO),
+    samples( 0)
+  {}
+
+  //! add one gyro reading / rad/s, dt / s
+  void add_sample( const float3vector & rate, float dt)
+  {
+    float3vector increment = rate * dt;
+    beta += ( alpha + last_increment * (ONE / 6.0f)).vector_multiply( increment) * HALF;
+    alpha += increment;
+    last_increment = increment;
+    interval += dt;
+    ++samples;
+  }
+
+  //! start a new interval, the last increment is kept for the coning formula
+  void reset( void)
+  {
+    alpha = float3vector();
+    beta = float3vector();
+    interval = ZERO;
+    samples = 0;
+  }
+
+  //! the same integration seen in another coordinate system (e.g. sensor -> airframe)
+  coning_integrator_t rotated( const float3matrix & mapping) const
+  {
+    coning_integrator_t retv( *this);
+    retv.alpha = mapping * alpha;
+    retv.beta = mapping * beta;
+    retv.last_increment = mapping * last_increment;
+    return retv;
+  }
+
+  //! rotation vector of the interval / rad
+  float3vector get_rotation_vector( void) const
+  {
+    return alpha + beta;
+  }
+  //! rotation rate averaged over the interval / rad/s
+  float3vector get_mean_rate( void) const
+  {
+    return alpha * ( ONE / interval);
+  }
+  //! coning part of the rotation vector / rad
+  const float3vector & get_coning_correction( void) const
+  {
+    return beta;
+  }
+  float get_interval( void) const
+  {
+    return interval;
+  }
+  unsigned get_samples( void) const
+  {
+    return samples;
+  }
+
+private:
+  float3vector alpha;		//!< sum of angle increments
+  float3vector beta;		//!< coning correction
+  float3vector last_increment;
+  float interval;		//!< integration time / s
+  unsigned samples;
+};
+
+#endif /* CONING_INTEGRATOR_H_ */
@@ -0,0 +1,123 @@
+/***********************************************************************//**
+ * @file		float3matrix_batch.h
+ * @brief		structure-of-arrays batch of 3x3 float matrices
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef FLOAT3MATRIX_BATCH_H_
+#define FLOAT3MATRIX_BATCH_H_
+
+#include "simd_lanes.h"
+#include "float3matrix.h"
+#include "float3vector_batch.h"
+
+//! N independent 3x3 matrices, stored element by element, see float3vector_batch
+template <int N> class float3matrix_batch
+{
+public:
+  static_assert( N % SIMD_LANES == 0, "batch size must be a multiple of SIMD_LANES");
+
+  //! default constructor creates unity matrices
+  float3matrix_batch( void)
+  {
+    for( int row = 0; row < 3; ++row)
+      for( int col = 0; col < 3; ++col)
+	for( int i = 0; i < N; ++i)
+	  e[row][col][i] = (row == col) ? ONE : ZERO;
+  }
+
+  //! get instance i as a scalar matrix
+  float3matrix get( int i) const
+  {
+    float3matrix retv;
+    for( int row = 0; row < 3; ++row)
+      for( int col = 0; col < 3; ++col)
+	retv.e[row][col] = e[row][col][i];
+    return retv;
+  }
+
+  //! set instance i from a scalar matrix
+  void set( int i, const float3matrix & m)
+  {
+    for( int row = 0; row < 3; ++row)
+      for( int col = 0; col < 3; ++col)
+	e[row][col][i] = m.e[row][col];
+  }
+
+  //! multiplication (matrix times vector) -> vector, instance by instance
+  void multiply( const float3vector_batch<N> & right, float3vector_batch<N> & result) const
+  {
+    map( right, result, false);
+  }
+
+  //! multiplication (transposed matrix times vector) -> vector, instance by instance
+  void reverse_map( const float3vector_batch<N> & right, float3vector_batch<N> & result) const
+  {
+    map( right, result, true);
+  }
+
+  float3vector_batch<N> operator * ( const float3vector_batch<N> & right) const
+  {
+    float3vector_batch<N> retv;
+    multiply( right, retv);
+    return retv;
+  }
+
+  float3vector_batch<N> reverse_map( const float3vector_batch<N> & right) const
+  {
+    float3vector_batch<N> retv;
+    reverse_map( right, retv);
+    return retv;
+  }
+
+  float e[3][3][N] __attribute__ ((aligned( SIMD_ALIGNMENT)));
+
+private:
+  void map( const float3vector_batch<N> & right, float3vector_batch<N> & result, bool transposed) const
+  {
+#if SIMD_LANES > 1
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes x = float_lanes::load( &right.e[0][i]);
+	float_lanes y = float_lanes::load( &right.e[1][i]);
+	float_lanes z = float_lanes::load( &right.e[2][i]);
+	for( int row = 0; row < 3; ++row)
+	  {
+	    const float * m0 = transposed ? e[0][row] : e[row][0];
+	    const float * m1 = transposed ? e[1][row] : e[row][1];
+	    const float * m2 = transposed ? e[2][row] : e[row][2];
+	    float_lanes tmp =   float_lanes::load( m0 + i) * x
+			      + float_lanes::load( m1 + i) * y
+			      + float_lanes::load( m2 + i) * z;
+	    tmp.store( &result.e[row][i]);
+	  }
+      }
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	float3matrix m = get( i);
+	result.set( i, transposed ? m.reverse_map( right.get( i)) : m * right.get( i));
+      }
+#endif
+  }
+};
+
+#endif /* FLOAT3MATRIX_BATCH_H_ */
@@ -0,0 +1,108 @@
+/***********************************************************************//**
+ * @file		float3vector_batch.h
+ * @brief		structure-of-arrays batch of 3d float vectors
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef FLOAT3VECTOR_BATCH_H_
+#define FLOAT3VECTOR_BATCH_H_
+
+#include "simd_lanes.h"
+#include "float3vector.h"
+
+/**
+ * @brief N independent 3d vectors, stored component by component
+ *
+ * e[component][instance] keeps the same component of all instances
+ * in one contiguous row, so SIMD_LANES instances are processed per instruction.
+ */
+template <int N> class float3vector_batch
+{
+public:
+  static_assert( N % SIMD_LANES == 0, "batch size must be a multiple of SIMD_LANES");
+
+  float3vector_batch( void)
+  {
+    for( int k = 0; k < 3; ++k)
+      for( int i = 0; i < N; ++i)
+	e[k][i] = ZERO;
+  }
+
+  //! get instance i as a scalar vector
+  float3vector get( int i) const
+  {
+    float3vector retv;
+    for( int k = 0; k < 3; ++k)
+      retv[k] = e[k][i];
+    return retv;
+  }
+
+  //! set instance i from a scalar vector
+  void set( int i, const float3vector & v)
+  {
+    for( int k = 0; k < 3; ++k)
+      e[k][i] = v[k];
+  }
+
+  float3vector_batch & operator += ( const float3vector_batch & right)
+  {
+    for( int k = 0; k < 3; ++k)
+      for( int i = 0; i < N; ++i)
+	e[k][i] += right.e[k][i];
+    return *this;
+  }
+
+  float3vector_batch & operator *= ( float factor)
+  {
+    for( int k = 0; k < 3; ++k)
+      for( int i = 0; i < N; ++i)
+	e[k][i] *= factor;
+    return *this;
+  }
+
+  //! normalize all instances to length ONE
+  void normalize( void)
+  {
+#if SIMD_LANES > 1
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes x = float_lanes::load( &e[0][i]);
+	float_lanes y = float_lanes::load( &e[1][i]);
+	float_lanes z = float_lanes::load( &e[2][i]);
+	float_lanes factor = float_lanes( ONE) / sqrt( x*x + y*y + z*z);
+	(x * factor).store( &e[0][i]);
+	(y * factor).store( &e[1][i]);
+	(z * factor).store( &e[2][i]);
+      }
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	float3vector v = get( i);
+	v.normalize();
+	set( i, v);
+      }
+#endif
+  }
+
+  float e[3][N] __attribute__ ((aligned( SIMD_ALIGNMENT)));
+};
+
+#endif /* FLOAT3VECTOR_BATCH_H_ */
@@ -0,0 +1,295 @@
+/***********************************************************************//**
+ * @file		pt2_fixed.h
+ * @brief		second order IIR low-pass filter in fixed-point arithmetic
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef PT2_FIXED_H_
+#define PT2_FIXED_H_
+
+#include <stdint.h>
+#include <assert.h>
+#include "pt2.h"
+
+/**
+ * Fixed-point variant of pt2 for targets without FPU: pt2< q_format<FRACTION_BITS>, basetype>.
+ *
+ * Coefficients are designed at compile time (C++14 constexpr) with the math of pt2
+ * (butterworth prototype at Fc/Fs = 0.25, frequency-transformed).
+ * Samples are q_format (int32_t) in any scaling chosen by the user,
+ * coefficients are Q2.30, products are accumulated in int64_t.
+ * The output saturates at the int32_t range, as the step response
+ * overshoots by a few percent near full scale.
+ * Cutoff frequencies up to PT2_FIXED_MAXIMUM_CUTOFF keep the sum of the
+ * coefficient magnitudes below 4, so the accumulator can not overflow.
+ * The filter uses direct form I, so the state keeps the scaling
+ * of the samples and can not overflow for low cutoff frequencies.
+ * The truncated output fraction is fed back into the next sample
+ * (fraction saving), which removes the rounding noise at DC
+ * that the poles near z=1 would amplify otherwise.
+ */
+
+#define PT2_FIXED_FRACTION_BITS 30
+#define PT2_FIXED_MAXIMUM_CUTOFF 0.35 //!< Fc/Fs limit, see above
+
+namespace pt2_fixed_design_math
+{
+  constexpr double PI = 3.14159265358979323846;
+
+  //! sine for constant expressions, Taylor series after range reduction
+  constexpr double sine( double x)
+  {
+    while( x > PI)
+      x -= 2.0 * PI;
+    while( x < -PI)
+      x += 2.0 * PI;
+    double term = x;
+    double sum = x;
+    for( int n = 1; n < 12; ++n)
+      {
+	term *= - x * x / ( (2 * n) * (2 * n + 1));
+	sum += term;
+      }
+    return sum;
+  }
+
+  constexpr int32_t to_fixed( double x)
+  {
+    return (int32_t)( x * (double)( 1L << PT2_FIXED_FRACTION_BITS) + ( x < 0.0 ? -0.5 : 0.5));
+  }
+
+  constexpr int64_t magnitude( int32_t x)
+  {
+    return x < 0 ? - (int64_t)x : x;
+  }
+
+  //! not constexpr: stops a compile-time design, asserts at runtime
+  inline void cutoff_out_of_range( void)
+  {
+    assert( 0);
+  }
+}
+
+//! z-transformed transfer function in Q2.30, a0 = 1
+struct pt2_fixed_coefficients
+{
+  int32_t b0, b1, b2, a1, a2;
+};
+
+//! design coefficients for a cutoff of Fc/Fs, same math as the pt2 constructor
+constexpr pt2_fixed_coefficients pt2_fixed_design( double fcutoff)
+{
+  using namespace pt2_fixed_design_math;
+
+  if( fcutoff <= 0.0 || fcutoff > PT2_FIXED_MAXIMUM_CUTOFF)
+    cutoff_out_of_range();
+
+  // butterworth filter prototype parameters at Fcutoff/Fsampling = 0.25
+  const double B0_ = 0.292893218813452;
+  const double B1_ = 0.585786437626905;
+  const double B2_ = 0.292893218813452;
+  const double A1_ = 0.0;
+  const double A2_ = 0.171572875253810;
+  const double DESIGN_FREQUENCY_ = 0.25;
+
+  double delta = sine( PI * (DESIGN_FREQUENCY_ - fcutoff)) / sine( PI * (fcutoff + DESIGN_FREQUENCY_));
+  double a0x = A2_ * delta * delta - A1_ + 1.0;
+  double a1x = -2.0 * delta * A2_ + (delta * delta + 1.0) * A1_ - 2.0 * delta;
+  double a2x = A2_ - delta * A1_ + delta * delta;
+
+  double b0x = B2_ * delta * delta - B1_ * delta + B0_;
+  double b2x = B2_ - delta * B1_ + delta * delta * B0_;
+
+  pt2_fixed_coefficients c = { 0, 0, 0, 0, 0};
+  c.a1 = to_fixed( a1x / a0x);
+  c.a2 = to_fixed( a2x / a0x);
+  c.b0 = to_fixed( b0x / a0x);
+  c.b2 = to_fixed( b2x / a0x);
+
+  // DC-gain = 1.0 exactly after quantization: b0 + b1 + b2 = 1 + a1 + a2
+  c.b1 = (int32_t)( ((int64_t)1 << PT2_FIXED_FRACTION_BITS) + c.a1 + c.a2 - c.b0 - c.b2);
+  return c;
+}
+
+//! headroom of the int64_t accumulator, the coefficient sum grows with the cutoff
+constexpr bool pt2_fixed_accumulator_headroom( const pt2_fixed_coefficients & c)
+{
+  using namespace pt2_fixed_design_math;
+  return magnitude( c.b0) + magnitude( c.b1) + magnitude( c.b2) + magnitude( c.a1) + magnitude( c.a2)
+      < ((int64_t)4 << PT2_FIXED_FRACTION_BITS);
+}
+
+static_assert( pt2_fixed_accumulator_headroom( pt2_fixed_design( PT2_FIXED_MAXIMUM_CUTOFF)),
+	       "int64_t accumulator may overflow at PT2_FIXED_MAXIMUM_CUTOFF");
+
+//! Q2.30 accumulator -> saturated output, the truncated fraction is kept in remainder
+inline int32_t pt2_fixed_output( int64_t accumulator, int32_t & remainder)
+{
+  int64_t output = accumulator >> PT2_FIXED_FRACTION_BITS; // rounds towards -infinity
+  if( output > INT32_MAX)
+    {
+      remainder = 0;
+      return INT32_MAX;
+    }
+  if( output < INT32_MIN)
+    {
+      remainder = 0;
+      return INT32_MIN;
+    }
+  remainder = (int32_t)( accumulator & (((int64_t)1 << PT2_FIXED_FRACTION_BITS) - 1));
+  return (int32_t)output;
+}
+
+//! signed fixed-point number with FRACTION_BITS fractional bits in an int32_t
+template <int FRACTION_BITS> class q_format
+{
+public:
+  q_format( void)
+  : value( 0)
+  {}
+  q_format( float x) //!< rounding, not for the fast path on targets without FPU
+  : value( (int32_t)( x * (float)( 1L << FRACTION_BITS) + ( x < 0.0f ? -0.5f : 0.5f)))
+  {}
+  operator float( void) const
+  {
+    return (float)value * ( 1.0f / (float)( 1L << FRACTION_BITS));
+  }
+  static q_format from_raw( int32_t raw)
+  {
+    q_format retv;
+    retv.value = raw;
+    return retv;
+  }
+  int32_t raw( void) const
+  {
+    return value;
+  }
+private:
+  int32_t value;
+};
+
+//! Second order IIR filter, fixed-point specialization
+template <int FRACTION_BITS, class basetype> class pt2< q_format<FRACTION_BITS>, basetype>
+{
+public:
+  typedef q_format<FRACTION_BITS> datatype;
+
+  //! constructor taking Fc/Fs, the design is folded at compile time for a constant cutoff
+  pt2( basetype fcutoff)
+  : pt2( pt2_fixed_design( fcutoff))
+  {}
+  //! guaranteed compile-time design: pt2< q_format<16>, float> filter( pt2_fixed_design( Fc/Fs));
+  pt2( const pt2_fixed_coefficients & _c)
+  : c( _c),
+    x1( 0), x2( 0),
+    y1( 0), y2( 0),
+    remainder( 0)
+  {}
+  void settle( const datatype &present_input)
+  {
+    x1 = x2 = y1 = y2 = present_input.raw();
+    remainder = 0;
+  }
+  datatype respond( const datatype &input)
+  {
+    int64_t accumulator =
+	  (int64_t)c.b0 * input.raw()
+	+ (int64_t)c.b1 * x1
+	+ (int64_t)c.b2 * x2
+	- (int64_t)c.a1 * y1
+	- (int64_t)c.a2 * y2
+	+ remainder; // fraction saving
+    int32_t output = pt2_fixed_output( accumulator, remainder);
+    x2 = x1;
+    x1 = input.raw();
+    y2 = y1;
+    y1 = output;
+    return datatype::from_raw( output);
+  }
+  datatype get_output( void) const
+  {
+    return datatype::from_raw( y1);
+  }
+  datatype get_last_input( void) const
+  {
+    return datatype::from_raw( x1);
+  }
+private:
+  pt2_fixed_coefficients c;
+  int32_t x1, x2; //!< past inputs
+  int32_t y1, y2; //!< past outputs
+  int32_t remainder; //!< truncated fraction of the last output, fed back
+};
+
+/**
+ * @brief CHANNELS filters with common coefficients, one sample per channel per call
+ *
+ * Raw int32_t samples, same arithmetic as pt2< q_format<>, basetype>.
+ * Structure-of-arrays state, the loop in respond() is vectorizable.
+ */
+template <int CHANNELS> class pt2_fixed_bank
+{
+public:
+  pt2_fixed_bank( const pt2_fixed_coefficients & _c)
+  : c( _c)
+  {
+    for( int i = 0; i < CHANNELS; ++i)
+      x1[i] = x2[i] = y1[i] = y2[i] = remainder[i] = 0;
+  }
+  void settle( const int32_t * present_input)
+  {
+    for( int i = 0; i < CHANNELS; ++i)
+      {
+	x1[i] = x2[i] = y1[i] = y2[i] = present_input[i];
+	remainder[i] = 0;
+      }
+  }
+  void respond( const int32_t * input, int32_t * output)
+  {
+    for( int i = 0; i < CHANNELS; ++i)
+      {
+	int64_t accumulator =
+	      (int64_t)c.b0 * input[i]
+	    + (int64_t)c.b1 * x1[i]
+	    + (int64_t)c.b2 * x2[i]
+	    - (int64_t)c.a1 * y1[i]
+	    - (int64_t)c.a2 * y2[i]
+	    + remainder[i];
+	int32_t out = pt2_fixed_output( accumulator, remainder[i]);
+	x2[i] = x1[i];
+	x1[i] = input[i];
+	y2[i] = y1[i];
+	y1[i] = out;
+	output[i] = out;
+      }
+  }
+  int32_t get_output( int channel) const
+  {
+    return y1[channel];
+  }
+private:
+  pt2_fixed_coefficients c;
+  int32_t x1[CHANNELS], x2[CHANNELS];
+  int32_t y1[CHANNELS], y2[CHANNELS];
+  int32_t remainder[CHANNELS];
+};
+
+#endif /* PT2_FIXED_H_ */
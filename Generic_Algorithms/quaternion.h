@@ -153,6 +153,39 @@ public:
 		normalize();
 	}
 
+	//! quaternion update using a finite rotation vector / rad, no truncation error
+	void rotate_exact( const vector <datatype, 3> &rotation)
+	{
+		datatype angle_squared = rotation * rotation;
+		datatype c, s; // cos( angle / 2), sin( angle / 2) / angle
+
+		if( angle_squared < 0.01f) // series expansion, error < 1e-11
+		  {
+		    c = ONE  - angle_squared * ( 0.125f      - angle_squared * ( ONE / 384.0f));
+		    s = HALF - angle_squared * ( ONE / 48.0f - angle_squared * ( ONE / 3840.0f));
+		  }
+		else
+		  {
+		    datatype angle = SQRT( angle_squared);
+		    c = COS( angle * HALF);
+		    s = SIN( angle * HALF) / angle;
+		  }
+
+		datatype p = rotation[0] * s;
+		datatype q = rotation[1] * s;
+		datatype r = rotation[2] * s;
+
+		datatype e0 = vector<datatype, 4>::e[0];
+		datatype e1 = vector<datatype, 4>::e[1];
+		datatype e2 = vector<datatype, 4>::e[2];
+		datatype e3 = vector<datatype, 4>::e[3];
+
+		vector<datatype, 4>::e[0] = c * e0 - e1*p - e2*q - e3*r;
+		vector<datatype, 4>::e[1] = c * e1 + e0*p + e2*r - e3*q;
+		vector<datatype, 4>::e[2] = c * e2 + e0*q - e1*r + e3*p;
+		vector<datatype, 4>::e[3] = c * e3 + e0*r + e1*q - e2*p;
+	}
+
 	//! euler angle -> quaternion transformation
 	void from_euler( datatype p, datatype q, datatype r)
 	{
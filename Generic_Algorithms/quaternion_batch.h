@@ -0,0 +1,193 @@
+/***********************************************************************//**
+ * @file		quaternion_batch.h
+ * @brief		structure-of-arrays batch of attitude quaternions
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef QUATERNION_BATCH_H_
+#define QUATERNION_BATCH_H_
+
+#include "simd_lanes.h"
+#include "quaternion.h"
+#include "float3vector_batch.h"
+#include "float3matrix_batch.h"
+
+/**
+ * @brief N independent attitude quaternions, stored component by component
+ *
+ * The formulas are the same as in quaternion<float>, see there.
+ */
+template <int N> class quaternion_batch
+{
+public:
+  static_assert( N % SIMD_LANES == 0, "batch size must be a multiple of SIMD_LANES");
+
+  //! default constructor creates unity quaternions
+  quaternion_batch( void)
+  {
+    for( int k = 0; k < 4; ++k)
+      for( int i = 0; i < N; ++i)
+	e[k][i] = (k == 0) ? ONE : ZERO;
+  }
+
+  //! get instance i as a scalar quaternion
+  quaternion<float> get( int i) const
+  {
+    quaternion<float> retv;
+    for( int k = 0; k < 4; ++k)
+      retv[k] = e[k][i];
+    return retv;
+  }
+
+  //! set instance i from a scalar quaternion
+  void set( int i, const quaternion<float> & q)
+  {
+    for( int k = 0; k < 4; ++k)
+      e[k][i] = q[k];
+  }
+
+  //! normalize all quaternions to absolute value ONE
+  void normalize( void)
+  {
+#if SIMD_LANES > 1
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes e0 = float_lanes::load( &e[0][i]);
+	float_lanes e1 = float_lanes::load( &e[1][i]);
+	float_lanes e2 = float_lanes::load( &e[2][i]);
+	float_lanes e3 = float_lanes::load( &e[3][i]);
+	float_lanes tmp = sqrt( float_lanes( ONE) / (e0*e0 + e1*e1 + e2*e2 + e3*e3));
+	(e0 * tmp).store( &e[0][i]);
+	(e1 * tmp).store( &e[1][i]);
+	(e2 * tmp).store( &e[2][i]);
+	(e3 * tmp).store( &e[3][i]);
+      }
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	quaternion<float> q = get( i);
+	q.normalize();
+	set( i, q);
+      }
+#endif
+  }
+
+  //! quaternion update using one rotation vector per instance
+  void rotate( const float3vector_batch<N> & rotation)
+  {
+#if SIMD_LANES > 1
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes p = float_lanes::load( &rotation.e[0][i]);
+	float_lanes q = float_lanes::load( &rotation.e[1][i]);
+	float_lanes r = float_lanes::load( &rotation.e[2][i]);
+	float_lanes e0 = float_lanes::load( &e[0][i]);
+	float_lanes e1 = float_lanes::load( &e[1][i]);
+	float_lanes e2 = float_lanes::load( &e[2][i]);
+	float_lanes e3 = float_lanes::load( &e[3][i]);
+
+	//! R.Rogers formula 2.92
+	(e0 + (float_lanes( ZERO) - e1*p - e2*q - e3*r)).store( &e[0][i]);
+	(e1 + (e0*p + e2*r - e3*q)).store( &e[1][i]);
+	(e2 + (e0*q - e1*r + e3*p)).store( &e[2][i]);
+	(e3 + (e0*r + e1*q - e2*p)).store( &e[3][i]);
+      }
+    normalize();
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	quaternion<float> q = get( i);
+	q.rotate( rotation.e[0][i], rotation.e[1][i], rotation.e[2][i]);
+	set( i, q);
+      }
+#endif
+  }
+
+  //! quaternion -> rotation matrix transformation for all instances
+  void get_rotation_matrix( float3matrix_batch<N> & m) const
+  {
+#if SIMD_LANES > 1
+    const float_lanes one( ONE);
+    const float_lanes two( TWO);
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes e0 = float_lanes::load( &e[0][i]);
+	float_lanes e1 = float_lanes::load( &e[1][i]);
+	float_lanes e2 = float_lanes::load( &e[2][i]);
+	float_lanes e3 = float_lanes::load( &e[3][i]);
+
+	//! R.Rogers formula 2.90
+	(two * (e0*e0 + e1*e1) - one).store( &m.e[0][0][i]);
+	(two * (e1*e2 - e0*e3)      ).store( &m.e[0][1][i]);
+	(two * (e1*e3 + e0*e2)      ).store( &m.e[0][2][i]);
+
+	(two * (e1*e2 + e0*e3)      ).store( &m.e[1][0][i]);
+	(two * (e0*e0 + e2*e2) - one).store( &m.e[1][1][i]);
+	(two * (e2*e3 - e0*e1)      ).store( &m.e[1][2][i]);
+
+	(two * (e1*e3 - e0*e2)      ).store( &m.e[2][0][i]);
+	(two * (e2*e3 + e0*e1)      ).store( &m.e[2][1][i]);
+	(two * (e0*e0 + e3*e3) - one).store( &m.e[2][2][i]);
+      }
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	float3matrix tmp;
+	get( i).get_rotation_matrix( tmp);
+	m.set( i, tmp);
+      }
+#endif
+  }
+
+  //! quaternion multiplication, instance by instance
+  quaternion_batch operator * ( const quaternion_batch & right) const
+  {
+    quaternion_batch result;
+#if SIMD_LANES > 1
+    for( int i = 0; i < N; i += SIMD_LANES)
+      {
+	float_lanes e0 = float_lanes::load( &e[0][i]);
+	float_lanes e1 = float_lanes::load( &e[1][i]);
+	float_lanes e2 = float_lanes::load( &e[2][i]);
+	float_lanes e3 = float_lanes::load( &e[3][i]);
+	float_lanes re0 = float_lanes::load( &right.e[0][i]);
+	float_lanes re1 = float_lanes::load( &right.e[1][i]);
+	float_lanes re2 = float_lanes::load( &right.e[2][i]);
+	float_lanes re3 = float_lanes::load( &right.e[3][i]);
+	(e0 * re0 - e1 * re1 - e2 * re2 + e3 * re3).store( &result.e[0][i]);
+	(e1 * re0 + e2 * re3 - e3 * re2 + e0 * re1).store( &result.e[1][i]);
+	(e3 * re1 + e0 * re2 - e1 * re3 + e2 * re0).store( &result.e[2][i]);
+	(e1 * re2 - e2 * re1 + e0 * re3 + e3 * re0).store( &result.e[3][i]);
+      }
+#else
+    for( int i = 0; i < N; ++i)
+      {
+	quaternion<float> r = right.get( i);
+	result.set( i, get( i) * r);
+      }
+#endif
+    return result;
+  }
+
+  float e[4][N] __attribute__ ((aligned( SIMD_ALIGNMENT)));
+};
+
+#endif /* QUATERNION_BATCH_H_ */
@@ -0,0 +1,141 @@
+/***********************************************************************//**
+ * @file		simd_lanes.h
+ * @brief		portable SIMD lane type for structure-of-arrays batch math
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef SIMD_LANES_H_
+#define SIMD_LANES_H_
+
+/**
+ * SIMD_LANES is the number of floats processed per instruction.
+ * On targets without a suitable vector unit (Cortex-M4) SIMD_LANES is 1
+ * and the batch classes fall back to the scalar vector / matrix / quaternion templates.
+ */
+
+#if defined( __AVX__)
+
+#include <immintrin.h>
+#define SIMD_LANES 8
+#define SIMD_ALIGNMENT 32
+
+//! eight floats in one AVX register
+class float_lanes
+{
+public:
+  float_lanes( void)
+  {}
+  float_lanes( __m256 _v)
+  : v( _v)
+  {}
+  explicit float_lanes( float x)
+  : v( _mm256_set1_ps( x))
+  {}
+  static float_lanes load( const float * data) //!< data must be SIMD_ALIGNMENT aligned
+  {
+    return _mm256_load_ps( data);
+  }
+  void store( float * data) const
+  {
+    _mm256_store_ps( data, v);
+  }
+  float_lanes operator + ( float_lanes right) const
+  {
+    return _mm256_add_ps( v, right.v);
+  }
+  float_lanes operator - ( float_lanes right) const
+  {
+    return _mm256_sub_ps( v, right.v);
+  }
+  float_lanes operator * ( float_lanes right) const
+  {
+    return _mm256_mul_ps( v, right.v);
+  }
+  float_lanes operator / ( float_lanes right) const
+  {
+    return _mm256_div_ps( v, right.v);
+  }
+  friend float_lanes sqrt( float_lanes x)
+  {
+    return _mm256_sqrt_ps( x.v);
+  }
+private:
+  __m256 v;
+};
+
+#elif defined( __ARM_NEON) && defined( __aarch64__)
+
+#include <arm_neon.h>
+#define SIMD_LANES 4
+#define SIMD_ALIGNMENT 16
+
+//! four floats in one NEON register
+class float_lanes
+{
+public:
+  float_lanes( void)
+  {}
+  float_lanes( float32x4_t _v)
+  : v( _v)
+  {}
+  explicit float_lanes( float x)
+  : v( vdupq_n_f32( x))
+  {}
+  static float_lanes load( const float * data)
+  {
+    return vld1q_f32( data);
+  }
+  void store( float * data) const
+  {
+    vst1q_f32( data, v);
+  }
+  float_lanes operator + ( float_lanes right) const
+  {
+    return vaddq_f32( v, right.v);
+  }
+  float_lanes operator - ( float_lanes right) const
+  {
+    return vsubq_f32( v, right.v);
+  }
+  float_lanes operator * ( float_lanes right) const
+  {
+    return vmulq_f32( v, right.v);
+  }
+  float_lanes operator / ( float_lanes right) const
+  {
+    return vdivq_f32( v, right.v);
+  }
+  friend float_lanes sqrt( float_lanes x)
+  {
+    return vsqrtq_f32( x.v);
+  }
+private:
+  float32x4_t v;
+};
+
+#else
+
+#define SIMD_LANES 1
+#define SIMD_ALIGNMENT 4
+
+#endif
+
+#endif /* SIMD_LANES_H_ */
@@ -0,0 +1,72 @@
+/***********************************************************************//**
+ * @file		spsc_queue.h
+ * @brief		lock-free single producer single consumer queue
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+/**
+ * @brief lock-free queue for exactly one producer and one consumer
+ *
+ * The producer may be an interrupt or high-priority task,
+ * the consumer a low-priority task or thread.
+ * Indices run freely, size must be a power of two.
+ */
+template <class datatype, unsigned size> class spsc_queue
+{
+  static_assert( (size & (size - 1)) == 0, "queue size must be a power of two");
+public:
+  spsc_queue( void)
+  : write_index( 0),
+    read_index( 0)
+  {}
+
+  //! producer side, @return true on error (queue full, value dropped)
+  bool push( const datatype & value)
+  {
+    unsigned w = write_index;
+    if( w - __atomic_load_n( &read_index, __ATOMIC_ACQUIRE) >= size)
+      return true;
+    buffer[w % size] = value;
+    __atomic_store_n( &write_index, w + 1, __ATOMIC_RELEASE);
+    return false;
+  }
+
+  //! consumer side, @return true if the queue is empty
+  bool pop( datatype & value)
+  {
+    unsigned r = read_index;
+    if( __atomic_load_n( &write_index, __ATOMIC_ACQUIRE) == r)
+      return true;
+    value = buffer[r % size];
+    __atomic_store_n( &read_index, r + 1, __ATOMIC_RELEASE);
+    return false;
+  }
+
+private:
+  datatype buffer[size];
+  unsigned write_index; //!< written by the producer only
+  unsigned read_index;  //!< written by the consumer only
+};
+
+#endif /* SPSC_QUEUE_H_ */
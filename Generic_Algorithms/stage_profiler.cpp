@@ -0,0 +1,125 @@
+/***********************************************************************//**
+ * @file		stage_profiler.cpp
+ * @brief		per-stage cycle count statistics for the real-time path
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "stage_profiler.h"
+#include "serial_io.h"
+
+#if STAGE_PROFILING
+
+#if UNIX == 1
+static thread_local stage_statistics_t stage_statistics[PROFILE_STAGES_END]; // one table per replay thread
+#else
+static stage_statistics_t stage_statistics[PROFILE_STAGES_END];
+#endif
+
+static const char * const stage_names[PROFILE_STAGES_END] =
+{
+  "AHRS",
+  "AHRS_mag",
+  "wind",
+  "vario",
+  "pressure",
+  "10Hz",
+  "mag_stat"
+};
+
+void stage_profiler_initialize( void)
+{
+#if UNIX != 1
+  *(volatile uint32_t *)0xE000EDFC |= 1 << 24; // DEMCR: TRCENA
+  DWT_CYCCNT = 0;
+  *(volatile uint32_t *)0xE0001000 |= 1;	// DWT_CTRL: CYCCNTENA
+#endif
+
+  for( unsigned stage = 0; stage < PROFILE_STAGES_END; ++stage)
+    {
+      stage_statistics_t & s = stage_statistics[stage];
+      s.count = 0;
+      s.min = 0xffffffff;
+      s.max = 0;
+      for( unsigned bin = 0; bin < PROFILE_HISTOGRAM_BINS; ++bin)
+	s.histogram[bin] = 0;
+    }
+}
+
+void stage_profiler_record( profiled_stage_t stage, uint32_t start_count)
+{
+  uint32_t duration = read_cycle_counter() - start_count;
+  stage_statistics_t & s = stage_statistics[stage];
+
+  if( s.count == 0) // table not initialized or freshly cleared
+    s.min = 0xffffffff;
+
+  ++s.count;
+  if( duration < s.min)
+    s.min = duration;
+  if( duration > s.max)
+    s.max = duration;
+
+  int bin = duration == 0 ? 0 : 31 - __builtin_clz( duration); // log2, CLZ instruction on Cortex-M
+  bin -= PROFILE_HISTOGRAM_FIRST_BIN;
+  if( bin < 0)
+    bin = 0;
+  if( bin >= PROFILE_HISTOGRAM_BINS)
+    bin = PROFILE_HISTOGRAM_BINS - 1;
+  ++s.histogram[bin];
+}
+
+const stage_statistics_t & get_stage_statistics( profiled_stage_t stage)
+{
+  return stage_statistics[stage];
+}
+
+void report_stage_statistics( serial_output & out)
+{
+  for( unsigned stage = 0; stage < PROFILE_STAGES_END; ++stage)
+    {
+      const stage_statistics_t & s = stage_statistics[stage];
+      if( s.count == 0)
+	continue;
+      out.puts( stage_names[stage]);
+      out.blank();
+      out.puti( s.count);
+      out.blank();
+      out.puti( s.min);
+      out.blank();
+      out.puti( s.max);
+      for( unsigned bin = 0; bin < PROFILE_HISTOGRAM_BINS; ++bin)
+	{
+	  out.blank();
+	  out.puti( s.histogram[bin]);
+	}
+      out.newline();
+    }
+}
+
+#else
+
+void report_stage_statistics( serial_output & out)
+{
+  out.puts( "stage profiling disabled");
+  out.newline();
+}
+
+#endif
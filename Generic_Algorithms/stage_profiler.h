@@ -0,0 +1,113 @@
+/***********************************************************************//**
+ * @file		stage_profiler.h
+ * @brief		per-stage cycle count statistics for the real-time path
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef STAGE_PROFILER_H_
+#define STAGE_PROFILER_H_
+
+#include "system_configuration.h"
+#include <stdint.h>
+
+#ifndef STAGE_PROFILING
+#define STAGE_PROFILING 0 //!< if 1: collect timing statistics for the stages below
+#endif
+
+//! the profiled stages of the real-time processing
+enum profiled_stage_t
+{
+  PROFILE_AHRS,			//!< AHRS update at 100 Hz
+  PROFILE_AHRS_MAGNETIC,	//!< magnetic-only AHRS (DEVELOPMENT_ADDITIONS)
+  PROFILE_WIND,			//!< wind observer at 100 Hz
+  PROFILE_VARIO,		//!< variometer at 100 Hz
+  PROFILE_PRESSURE,		//!< pressure and pitot update
+  PROFILE_SLOW_PATH,		//!< everything running at 10 Hz
+  PROFILE_MAG_STATISTICS,	//!< magnetic calibration statistics while circling, part of PROFILE_AHRS
+  PROFILE_STAGES_END
+};
+
+#define PROFILE_HISTOGRAM_BINS 16
+#define PROFILE_HISTOGRAM_FIRST_BIN 8 //!< bin 0 collects all durations < 2^(8+1) cycles
+
+//! timing statistics of one stage, all durations in cycles (host: TSC ticks or ns)
+typedef struct
+{
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint32_t histogram[PROFILE_HISTOGRAM_BINS]; //!< bin i: duration < 2^(i+9) cycles
+} stage_statistics_t;
+
+#if STAGE_PROFILING
+
+#if UNIX == 1
+
+#if defined( __x86_64__) || defined( __i386__)
+#include <x86intrin.h>
+inline uint32_t read_cycle_counter( void)
+{
+  return (uint32_t)__rdtsc();
+}
+#else
+#include <chrono>
+inline uint32_t read_cycle_counter( void)
+{
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#else // Cortex-M data watchpoint and trace unit
+
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+
+inline uint32_t read_cycle_counter( void)
+{
+  return DWT_CYCCNT;
+}
+
+#endif
+
+//! enable the cycle counter and clear all statistics
+void stage_profiler_initialize( void);
+
+//! add one measurement, wrap-around of the 32-bit counter is handled by the subtraction
+void stage_profiler_record( profiled_stage_t stage, uint32_t start_count);
+
+const stage_statistics_t & get_stage_statistics( profiled_stage_t stage);
+
+#define PROFILE_START( stage) uint32_t stage ## _start_count = read_cycle_counter()
+#define PROFILE_STOP( stage)  stage_profiler_record( stage, stage ## _start_count)
+
+#else
+
+#define PROFILE_START( stage)
+#define PROFILE_STOP( stage)
+
+#endif
+
+class serial_output;
+
+//! print one line per stage: name count min max histogram
+void report_stage_statistics( serial_output & out);
+
+#endif /* STAGE_PROFILER_H_ */
@@ -0,0 +1,329 @@
+/***********************************************************************//**
+ * @file		steady_state_kalman.h
+ * @brief		steady-state Kalman filter, gains designed at compile time
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef STEADY_STATE_KALMAN_H_
+#define STEADY_STATE_KALMAN_H_
+
+/**
+ * Steady-state Kalman filter for linear time-invariant systems.
+ *
+ * x = A * x, x = x + K * ( y - C * x)
+ *
+ * The gain K is designed at compile time (C++14 constexpr) from A, C and the
+ * noise covariances Q, R by solving the discrete algebraic Riccati equation
+ * P = A P A' - A P C' (C P C' + R)^-1 C P A' + Q
+ * with the structure-preserving doubling algorithm (quadratic convergence).
+ * This is the limit of the P / K iteration in the MATLAB scripts of Filter_Design/.
+ */
+
+//! system model and noise specification in double precision
+template< unsigned N, unsigned L> struct steady_state_kalman_model
+{
+  double A[N][N]; //!< system dynamics
+  double C[L][N]; //!< measurement
+  double Q[N][N]; //!< process noise covariance
+  double R[L][L]; //!< measurement noise covariance
+};
+
+//! single precision Kalman gain
+template< unsigned N, unsigned L> struct steady_state_kalman_gain
+{
+  float K[N][L];
+};
+
+//! single precision coefficients for the filter
+template< unsigned N, unsigned L> struct steady_state_kalman_coefficients
+{
+  float A[N][N];
+  float C[L][N];
+  steady_state_kalman_gain<N,L> gain;
+};
+
+namespace kalman_design_math
+{
+  template< unsigned R, unsigned C> struct design_matrix
+  {
+    double m[R][C];
+  };
+
+  template< unsigned R, unsigned C> constexpr design_matrix<R,C> zero( void)
+  {
+    design_matrix<R,C> result = {};
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	result.m[i][k] = 0.0;
+    return result;
+  }
+
+  template< unsigned N> constexpr design_matrix<N,N> identity( void)
+  {
+    design_matrix<N,N> result = zero<N,N>();
+    for( unsigned i = 0; i < N; ++i)
+      result.m[i][i] = 1.0;
+    return result;
+  }
+
+  template< unsigned R, unsigned C> constexpr design_matrix<R,C> from( const double (&a)[R][C])
+  {
+    design_matrix<R,C> result = {};
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	result.m[i][k] = a[i][k];
+    return result;
+  }
+
+  template< unsigned R, unsigned C> constexpr design_matrix<C,R> transpose( const design_matrix<R,C> & a)
+  {
+    design_matrix<C,R> result = {};
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	result.m[k][i] = a.m[i][k];
+    return result;
+  }
+
+  template< unsigned R, unsigned C> constexpr design_matrix<R,C> add( const design_matrix<R,C> & a, const design_matrix<R,C> & b)
+  {
+    design_matrix<R,C> result = {};
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	result.m[i][k] = a.m[i][k] + b.m[i][k];
+    return result;
+  }
+
+  template< unsigned R, unsigned M, unsigned C> constexpr design_matrix<R,C> multiply( const design_matrix<R,M> & a, const design_matrix<M,C> & b)
+  {
+    design_matrix<R,C> result = {};
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	{
+	  double sum = 0.0;
+	  for( unsigned j = 0; j < M; ++j)
+	    sum += a.m[i][j] * b.m[j][k];
+	  result.m[i][k] = sum;
+	}
+    return result;
+  }
+
+  //! Gauss-Jordan elimination with partial pivoting, the matrix must be regular
+  template< unsigned N> constexpr design_matrix<N,N> inverse( const design_matrix<N,N> & a)
+  {
+    design_matrix<N,N> work = a;
+    design_matrix<N,N> result = identity<N>();
+    for( unsigned column = 0; column < N; ++column)
+      {
+	unsigned pivot = column;
+	for( unsigned row = column + 1; row < N; ++row)
+	  if( ( work.m[row][column] < 0.0 ? -work.m[row][column] : work.m[row][column]) >
+	      ( work.m[pivot][column] < 0.0 ? -work.m[pivot][column] : work.m[pivot][column]))
+	    pivot = row;
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    double tmp = work.m[column][k];
+	    work.m[column][k] = work.m[pivot][k];
+	    work.m[pivot][k] = tmp;
+	    tmp = result.m[column][k];
+	    result.m[column][k] = result.m[pivot][k];
+	    result.m[pivot][k] = tmp;
+	  }
+	double scale = 1.0 / work.m[column][column];
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    work.m[column][k] *= scale;
+	    result.m[column][k] *= scale;
+	  }
+	for( unsigned row = 0; row < N; ++row)
+	  if( row != column)
+	    {
+	      double factor = work.m[row][column];
+	      for( unsigned k = 0; k < N; ++k)
+		{
+		  work.m[row][k] -= factor * work.m[column][k];
+		  result.m[row][k] -= factor * result.m[column][k];
+		}
+	    }
+      }
+    return result;
+  }
+
+  //! largest absolute element
+  template< unsigned R, unsigned C> constexpr double norm( const design_matrix<R,C> & a)
+  {
+    double result = 0.0;
+    for( unsigned i = 0; i < R; ++i)
+      for( unsigned k = 0; k < C; ++k)
+	{
+	  double element = a.m[i][k] < 0.0 ? -a.m[i][k] : a.m[i][k];
+	  if( element > result)
+	    result = element;
+	}
+    return result;
+  }
+
+  /**
+   * @brief stationary a-priori error covariance P
+   *
+   * Doubling algorithm for X = F' X (I + G X)^-1 F + H
+   * with F = A', G = C' R^-1 C, H = Q.
+   */
+  template< unsigned N, unsigned L> constexpr design_matrix<N,N> riccati_solution( const steady_state_kalman_model<N,L> & model)
+  {
+    design_matrix<L,N> C = from( model.C);
+    design_matrix<N,N> F = transpose( from( model.A));
+    design_matrix<N,N> G = multiply( multiply( transpose( C), inverse( from( model.R))), C);
+    design_matrix<N,N> H = from( model.Q);
+
+    for( unsigned iteration = 0; iteration < 64; ++iteration)
+      {
+	design_matrix<N,N> W_inverse = inverse( add( identity<N>(), multiply( G, H)));
+	design_matrix<N,N> F_W = multiply( F, W_inverse);
+	design_matrix<N,N> next_H = add( H, multiply( multiply( transpose( F), H), multiply( W_inverse, F)));
+	G = add( G, multiply( multiply( F_W, G), transpose( F)));
+	F = multiply( F_W, F);
+
+	design_matrix<N,N> change = next_H;
+	for( unsigned i = 0; i < N; ++i)
+	  for( unsigned k = 0; k < N; ++k)
+	    change.m[i][k] -= H.m[i][k];
+	H = next_H;
+	if( norm( change) <= 1e-15 * norm( H))
+	  break;
+      }
+    return H;
+  }
+}
+
+//! compile-time design: Kalman gain K = P C' (C P C' + R)^-1
+template< unsigned N, unsigned L>
+constexpr steady_state_kalman_coefficients<N,L> steady_state_kalman_design( const steady_state_kalman_model<N,L> & model)
+{
+  using namespace kalman_design_math;
+
+  design_matrix<N,N> P = riccati_solution( model);
+  design_matrix<L,N> C = from( model.C);
+  design_matrix<N,L> P_Ct = multiply( P, transpose( C));
+  design_matrix<N,L> K = multiply( P_Ct, inverse( add( multiply( C, P_Ct), from( model.R))));
+
+  steady_state_kalman_coefficients<N,L> coefficients = {};
+  for( unsigned i = 0; i < N; ++i)
+    {
+      for( unsigned k = 0; k < N; ++k)
+	coefficients.A[i][k] = (float)model.A[i][k];
+      for( unsigned k = 0; k < L; ++k)
+	coefficients.gain.K[i][k] = (float)K.m[i][k];
+    }
+  for( unsigned i = 0; i < L; ++i)
+    for( unsigned k = 0; k < N; ++k)
+      coefficients.C[i][k] = (float)model.C[i][k];
+  return coefficients;
+}
+
+/**
+ * @brief steady-state Kalman filter, state vector x[N], measurement vector y[L]
+ *
+ * design: struct with enum { N, L } and
+ * static constexpr steady_state_kalman_model<N,L> model( void)
+ *
+ * A and C are compile-time constants, the update is fully unrolled
+ * and skips their zero and unity elements. The gain is a RAM copy.
+ */
+template< class design> class steady_state_kalman
+{
+public:
+  enum { N = design::N, L = design::L };
+  typedef steady_state_kalman_coefficients<N,L> coefficients_t;
+
+  static constexpr coefficients_t coefficients = steady_state_kalman_design( design::model());
+
+  steady_state_kalman( void)
+  : gain( coefficients.gain),
+    x{}
+  {}
+
+  //! prediction and correction
+  void update( const float (&y)[L])
+  {
+    float x_est[N];
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < N; ++i)
+      {
+	float sum = 0.0f;
+	bool first = true;
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    const float a = coefficients.A[i][k];
+	    if( a == 0.0f)
+	      continue;
+	    const float term = a == 1.0f ? x[k] : a * x[k];
+	    sum = first ? term : sum + term;
+	    first = false;
+	  }
+	x_est[i] = sum;
+      }
+
+    float innovation[L];
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < L; ++i)
+      {
+	float sum = y[i];
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    const float c = coefficients.C[i][k];
+	    if( c == 0.0f)
+	      continue;
+	    sum -= c == 1.0f ? x_est[k] : c * x_est[k];
+	  }
+	innovation[i] = sum;
+      }
+
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < N; ++i)
+      {
+	float sum = x_est[i];
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < L; ++k)
+	  sum += gain.K[i][k] * innovation[k];
+	x[i] = sum;
+      }
+  }
+
+  float get_x( unsigned index) const
+  {
+    return x[index];
+  }
+  void set_x( unsigned index, float value)
+  {
+    x[index] = value;
+  }
+
+private:
+  steady_state_kalman_gain<N,L> gain; //!< RAM copy
+  float x[N]; //!< state vector
+};
+
+template< class design>
+constexpr typename steady_state_kalman< design>::coefficients_t steady_state_kalman< design>::coefficients;
+
+#endif /* STEADY_STATE_KALMAN_H_ */
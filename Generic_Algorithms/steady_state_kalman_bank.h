@@ -0,0 +1,304 @@
+/***********************************************************************//**
+ * @file		steady_state_kalman_bank.h
+ * @brief		four steady-state Kalman filters updated side by side
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef STEADY_STATE_KALMAN_BANK_H_
+#define STEADY_STATE_KALMAN_BANK_H_
+
+#include "steady_state_kalman.h"
+
+/**
+ * Four independent steady-state Kalman filters with their states stored side by side.
+ *
+ * Coefficients are [row][column][lane], padded to the largest state and measurement size.
+ * Padded states and measurements have zero coefficients and remain zero.
+ *
+ * With KALMAN_BANK_SIMD one vector instruction (SSE / NEON) handles all four lanes,
+ * a coefficient is skipped only if it is zero in all lanes.
+ * Without (Cortex-M4, scalar FPU) zero coefficients are skipped per lane,
+ * so the bank does the arithmetic of the single filters in one pass.
+ */
+#define KALMAN_BANK_LANES 4
+
+#ifndef KALMAN_BANK_SIMD
+#if defined( __SSE2__) || defined( __ARM_NEON)
+#define KALMAN_BANK_SIMD 1
+#else
+#define KALMAN_BANK_SIMD 0
+#endif
+#endif
+
+//! one float per lane, GCC vector extension, element access by [lane]
+typedef float kalman_bank_lanes __attribute__ ((vector_size( KALMAN_BANK_LANES * sizeof( float))));
+
+//! padded lane-interleaved coefficients
+template< unsigned N, unsigned L> struct steady_state_kalman_bank_coefficients
+{
+  float A[N][N][KALMAN_BANK_LANES];
+  float C[L][N][KALMAN_BANK_LANES];
+  float K[N][L][KALMAN_BANK_LANES];
+};
+
+//! coefficient classification, decides the operations of the update at compile time
+enum { ZERO_IN_ALL_LANES, UNITY_IN_ALL_LANES, GENERAL_COEFFICIENT };
+
+template< unsigned N, unsigned L> struct steady_state_kalman_bank_pattern
+{
+  unsigned char A[N][N];
+  unsigned char C[L][N];
+};
+
+//! copy the coefficients of one filter into its lane
+template< unsigned N, unsigned L, unsigned n, unsigned l>
+constexpr void steady_state_kalman_bank_insert(
+    steady_state_kalman_bank_coefficients<N,L> & bank,
+    const steady_state_kalman_coefficients<n,l> & filter,
+    unsigned lane)
+{
+  for( unsigned i = 0; i < n; ++i)
+    {
+      for( unsigned k = 0; k < n; ++k)
+	bank.A[i][k][lane] = filter.A[i][k];
+      for( unsigned k = 0; k < l; ++k)
+	bank.K[i][k][lane] = filter.gain.K[i][k];
+    }
+  for( unsigned i = 0; i < l; ++i)
+    for( unsigned k = 0; k < n; ++k)
+      bank.C[i][k][lane] = filter.C[i][k];
+}
+
+constexpr unsigned char steady_state_kalman_bank_classify( const float (&coefficient)[KALMAN_BANK_LANES])
+{
+  bool zero = true;
+  bool unity = true;
+  for( unsigned lane = 0; lane < KALMAN_BANK_LANES; ++lane)
+    {
+      zero  = zero  && coefficient[lane] == 0.0f;
+      unity = unity && coefficient[lane] == 1.0f;
+    }
+  return zero ? ZERO_IN_ALL_LANES : unity ? UNITY_IN_ALL_LANES : GENERAL_COEFFICIENT;
+}
+
+template< unsigned N, unsigned L>
+constexpr steady_state_kalman_bank_pattern<N,L> steady_state_kalman_bank_classify( const steady_state_kalman_bank_coefficients<N,L> & bank)
+{
+  steady_state_kalman_bank_pattern<N,L> pattern = {};
+  for( unsigned i = 0; i < N; ++i)
+    for( unsigned k = 0; k < N; ++k)
+      pattern.A[i][k] = steady_state_kalman_bank_classify( bank.A[i][k]);
+  for( unsigned i = 0; i < L; ++i)
+    for( unsigned k = 0; k < N; ++k)
+      pattern.C[i][k] = steady_state_kalman_bank_classify( bank.C[i][k]);
+  return pattern;
+}
+
+/**
+ * @brief four steady-state Kalman filters updated in one pass
+ *
+ * design0 .. design3: see steady_state_kalman
+ * Zero coefficients are skipped at compile time and unity coefficients
+ * need no multiplication, see KALMAN_BANK_SIMD.
+ * The results are bit-identical to four steady_state_kalman updates.
+ */
+template< class design0, class design1, class design2, class design3> class steady_state_kalman_bank
+{
+public:
+  enum
+  {
+    LANES = KALMAN_BANK_LANES,
+    ALL_LANES = ( 1 << KALMAN_BANK_LANES) - 1,
+    N01 = (unsigned)design0::N > (unsigned)design1::N ? (unsigned)design0::N : (unsigned)design1::N,
+    N23 = (unsigned)design2::N > (unsigned)design3::N ? (unsigned)design2::N : (unsigned)design3::N,
+    L01 = (unsigned)design0::L > (unsigned)design1::L ? (unsigned)design0::L : (unsigned)design1::L,
+    L23 = (unsigned)design2::L > (unsigned)design3::L ? (unsigned)design2::L : (unsigned)design3::L,
+    N = (unsigned)N01 > (unsigned)N23 ? (unsigned)N01 : (unsigned)N23, //!< padded state size
+    L = (unsigned)L01 > (unsigned)L23 ? (unsigned)L01 : (unsigned)L23  //!< padded measurement size
+  };
+  typedef steady_state_kalman_bank_coefficients<N,L> coefficients_t;
+  typedef steady_state_kalman_bank_pattern<N,L> pattern_t;
+
+  static constexpr coefficients_t design( void)
+  {
+    coefficients_t bank = {};
+    steady_state_kalman_bank_insert( bank, steady_state_kalman< design0>::coefficients, 0);
+    steady_state_kalman_bank_insert( bank, steady_state_kalman< design1>::coefficients, 1);
+    steady_state_kalman_bank_insert( bank, steady_state_kalman< design2>::coefficients, 2);
+    steady_state_kalman_bank_insert( bank, steady_state_kalman< design3>::coefficients, 3);
+    return bank;
+  }
+
+  static constexpr coefficients_t coefficients = design();
+  static constexpr pattern_t pattern = steady_state_kalman_bank_classify( coefficients);
+
+  steady_state_kalman_bank( void)
+  {
+    for( unsigned i = 0; i < N; ++i)
+      {
+	for( unsigned k = 0; k < L; ++k)
+	  K[i][k] = lanes( coefficients.K[i][k]);
+	x[i] = kalman_bank_lanes{};
+      }
+  }
+
+  /**
+   * @brief prediction and correction of all filters
+   * @param y measurements, y[channel][lane], unused channels must be zero
+   * @param lane_mask bit n set = update lane n, the other lanes keep their state
+   */
+  void update( const float (&y)[L][LANES], unsigned lane_mask = ALL_LANES)
+  {
+    kalman_bank_lanes x_est[N];
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < N; ++i)
+      {
+	x_est[i] = kalman_bank_lanes{};
+	bool first[LANES] = { true, true, true, true };
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    if( pattern.A[i][k] == ZERO_IN_ALL_LANES)
+	      continue;
+	    if( KALMAN_BANK_SIMD)
+	      {
+		const kalman_bank_lanes term = pattern.A[i][k] == UNITY_IN_ALL_LANES ? x[k] : lanes( coefficients.A[i][k]) * x[k];
+		x_est[i] = first[0] ? term : x_est[i] + term;
+		first[0] = false;
+		continue;
+	      }
+#pragma GCC unroll 4
+	    for( unsigned lane = 0; lane < LANES; ++lane)
+	      {
+		const float a = coefficients.A[i][k][lane];
+		if( a == 0.0f)
+		  continue;
+		const float term = a == 1.0f ? x[k][lane] : a * x[k][lane];
+		x_est[i][lane] = first[lane] ? term : x_est[i][lane] + term;
+		first[lane] = false;
+	      }
+	  }
+      }
+
+    kalman_bank_lanes innovation[L];
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < L; ++i)
+      {
+	innovation[i] = lanes( y[i]);
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < N; ++k)
+	  {
+	    if( pattern.C[i][k] == ZERO_IN_ALL_LANES)
+	      continue;
+	    if( KALMAN_BANK_SIMD)
+	      {
+		innovation[i] -= pattern.C[i][k] == UNITY_IN_ALL_LANES ? x_est[k] : lanes( coefficients.C[i][k]) * x_est[k];
+		continue;
+	      }
+#pragma GCC unroll 4
+	    for( unsigned lane = 0; lane < LANES; ++lane)
+	      {
+		const float c = coefficients.C[i][k][lane];
+		if( c != 0.0f)
+		  innovation[i][lane] -= c == 1.0f ? x_est[k][lane] : c * x_est[k][lane];
+	      }
+	  }
+      }
+
+#pragma GCC unroll 16
+    for( unsigned i = 0; i < N; ++i)
+      {
+#pragma GCC unroll 16
+	for( unsigned k = 0; k < L; ++k)
+	  {
+	    if( KALMAN_BANK_SIMD)
+	      {
+		x_est[i] += K[i][k] * innovation[k];
+		continue;
+	      }
+#pragma GCC unroll 4
+	    for( unsigned lane = 0; lane < LANES; ++lane)
+	      if( coefficients.K[i][k][lane] != 0.0f) // skip the padding
+		x_est[i][lane] += K[i][k][lane] * innovation[k][lane];
+	  }
+
+	if( lane_mask == ALL_LANES)
+	  x[i] = x_est[i];
+	else
+#pragma GCC unroll 4
+	  for( unsigned lane = 0; lane < LANES; ++lane)
+	    if( lane_mask & ( 1 << lane))
+	      x[i][lane] = x_est[i][lane];
+      }
+  }
+
+  float get_x( unsigned lane, unsigned index) const
+  {
+    return x[index][lane];
+  }
+  void set_x( unsigned lane, unsigned index, float value)
+  {
+    x[index][lane] = value;
+  }
+
+private:
+  static kalman_bank_lanes lanes( const float (&value)[LANES])
+  {
+    return kalman_bank_lanes{ value[0], value[1], value[2], value[3] };
+  }
+
+  kalman_bank_lanes K[N][L]; //!< RAM copy of the gains
+  kalman_bank_lanes x[N]; //!< state vectors
+};
+
+template< class design0, class design1, class design2, class design3>
+constexpr typename steady_state_kalman_bank< design0, design1, design2, design3>::coefficients_t
+  steady_state_kalman_bank< design0, design1, design2, design3>::coefficients;
+
+template< class design0, class design1, class design2, class design3>
+constexpr typename steady_state_kalman_bank< design0, design1, design2, design3>::pattern_t
+  steady_state_kalman_bank< design0, design1, design2, design3>::pattern;
+
+/**
+ * @brief one filter of a steady_state_kalman_bank
+ *
+ * Gives the interface of the single filter classes, e.g.
+ * lane.get_x( KalmanVario_PVA_t::VARIO)
+ */
+template< class bank_t, unsigned lane> class steady_state_kalman_lane
+{
+public:
+  explicit steady_state_kalman_lane( bank_t & _bank)
+  : bank( _bank)
+  {}
+  float get_x( unsigned index) const
+  {
+    return bank.get_x( lane, index);
+  }
+  void set_x( unsigned index, float value)
+  {
+    bank.set_x( lane, index, value);
+  }
+private:
+  bank_t & bank;
+};
+
+#endif /* STEADY_STATE_KALMAN_BANK_H_ */
@@ -0,0 +1,72 @@
+/***********************************************************************//**
+ * @file		triple_buffer.h
+ * @brief		wait-free publication of data between two tasks
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef TRIPLE_BUFFER_H_
+#define TRIPLE_BUFFER_H_
+
+/**
+ * @brief hand over the most recent data set from one writer to one reader
+ *
+ * Writer and reader own one buffer each, the third one is exchanged atomically.
+ * Neither side ever waits, the reader always gets a consistent set.
+ */
+template <class datatype> class triple_buffer
+{
+public:
+  triple_buffer( void)
+  : buffer(),
+    back( 0),
+    middle( 1),
+    front( 2)
+  {}
+
+  //! writer side: fill this buffer, then publish()
+  datatype & get_write_buffer( void)
+  {
+    return buffer[back];
+  }
+
+  //! writer side: make the write buffer visible to the reader
+  void publish( void)
+  {
+    back = __atomic_exchange_n( &middle, back | FRESH, __ATOMIC_ACQ_REL) & INDEX_MASK;
+  }
+
+  //! reader side: most recently published data, valid until the next call
+  const datatype & read( void)
+  {
+    if( __atomic_load_n( &middle, __ATOMIC_RELAXED) & FRESH)
+      front = __atomic_exchange_n( &middle, front, __ATOMIC_ACQ_REL) & INDEX_MASK;
+    return buffer[front];
+  }
+
+private:
+  enum { INDEX_MASK = 3, FRESH = 4};
+  datatype buffer[3];
+  unsigned back;	//!< owned by the writer
+  unsigned middle;	//!< exchanged, FRESH flag set when new data are available
+  unsigned front;	//!< owned by the reader
+};
+
+#endif /* TRIPLE_BUFFER_H_ */
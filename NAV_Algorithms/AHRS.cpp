@@ -28,6 +28,7 @@
 #include "magnetic_induction_report.h"
 #include "embedded_memory.h"
 #include "NAV_tuning_parameters.h"
+#include "stage_profiler.h"
 
 #if USE_HARDWARE_EEPROM	== 0
 #include "EEPROM_emulation.h"
@@ -71,7 +72,7 @@ AHRS_type::attitude_setup (const float3vector &acceleration,
   float3matrix coordinates (fcoordinates);
   attitude.from_rotation_matrix (coordinates);
   attitude.get_rotation_matrix (body2nav);
-  euler = attitude;
+  euler_valid = false;
 }
 
 /**
@@ -109,15 +110,17 @@ void AHRS_type::feed_magnetic_induction_observer(const float3vector &mag_sensor)
   float3vector expected_body_induction = body2nav.reverse_map(expected_nav_induction);
   bool turning_right = turn_rate_averager.get_output() > 0.0f;
 
+  PROFILE_START( PROFILE_MAG_STATISTICS); // USE_CENTERED_FLOAT_STATISTICS 0 / 1 on the target
   for (unsigned i = 0; i < 3; ++i)
     if( turning_right)
       mag_calibration_data_collector_right_turn[i].add_value ( MAG_SCALE * expected_body_induction[i], MAG_SCALE * mag_sensor[i]);
     else
       mag_calibration_data_collector_left_turn[i].add_value ( MAG_SCALE * expected_body_induction[i], MAG_SCALE * mag_sensor[i]);
+  PROFILE_STOP( PROFILE_MAG_STATISTICS);
 
 #if USE_EARTH_INDUCTION_DATA_COLLECTOR
   // measurement of earth induction to find the local earth field parameters
-  earth_induction_data_collector.feed( induction_nav_frame, turning_right);
+  earth_induction_data_collector.feed( get_nav_induction(), turning_right);
 #endif
 }
 
@@ -131,8 +134,10 @@ AHRS_type::AHRS_type (float sampling_time)
   circling_state( STRAIGHT_FLIGHT),
   nav_correction(),
   gyro_correction(),
+  coning_correction(),
   acceleration_nav_frame(),
   induction_nav_frame(),
+  body_induction(),
   expected_nav_induction(),
   body2nav(),
   euler(),
@@ -152,7 +157,11 @@ AHRS_type::AHRS_type (float sampling_time)
   magnetic_control_gain(1.0f),
   automatic_magnetic_calibration(configuration(MAG_AUTO_CALIB)),
   automatic_earth_field_parameters( false),
-  magnetic_calibration_updated( false)
+  magnetic_calibration_updated( false),
+  magnetic_calibration_type( 'm'),
+  euler_valid( false),
+  induction_cache_valid( false),
+  coning_correction_pending( false)
 {
   update_magnetic_loop_gain(); // adapt to magnetic inclination
 
@@ -161,6 +170,7 @@ AHRS_type::AHRS_type (float sampling_time)
     compass_calibration.set_default();
 }
 
+template< class heading_aiding, class circling_aiding>
 void
 AHRS_type::update (const float3vector &gyro,
 		   const float3vector &acc,
@@ -169,14 +179,23 @@ AHRS_type::update (const float3vector &gyro,
 		   float GNSS_heading,
 		   bool GNSS_heading_valid)
 {
-#if DISABLE_SAT_COMPASS
-  update_compass(gyro, acc, mag, GNSS_acceleration);
-#else
-  if( GNSS_heading_valid)
-    update_diff_GNSS (gyro, acc, mag, GNSS_acceleration, GNSS_heading);
+  if( heading_aiding::USE_D_GNSS && GNSS_heading_valid)
+    update_diff_GNSS< circling_aiding> (gyro, acc, mag, GNSS_acceleration, GNSS_heading);
+  else if( heading_aiding::USE_COMPASS)
+    update_compass< circling_aiding> (gyro, acc, mag, GNSS_acceleration);
   else
-    update_compass(gyro, acc, mag, GNSS_acceleration);
-#endif
+    update_ACC_only (gyro, acc, mag, GNSS_acceleration);
+}
+
+void
+AHRS_type::update (const float3vector &gyro,
+		   const float3vector &acc,
+		   const float3vector &mag,
+		   const float3vector &GNSS_acceleration,
+		   float GNSS_heading,
+		   bool GNSS_heading_valid)
+{
+  update< default_heading_aiding, default_circling_aiding> (gyro, acc, mag, GNSS_acceleration, GNSS_heading, GNSS_heading_valid);
 }
 
 /**
@@ -189,17 +208,24 @@ AHRS_type::update_attitude ( const float3vector &acc,
 			     const float3vector &gyro,
 			     const float3vector &mag)
 {
-  attitude.rotate (gyro[ROLL] * Ts_div_2,
-		   gyro[PITCH] * Ts_div_2,
-		   gyro[YAW]  * Ts_div_2);
+  if( coning_correction_pending) // gyro has been integrated at the IMU rate
+    {
+      attitude.rotate_exact( gyro * Ts + coning_correction);
+      coning_correction_pending = false;
+    }
+  else
+    attitude.rotate (gyro[ROLL] * Ts_div_2,
+		     gyro[PITCH] * Ts_div_2,
+		     gyro[YAW]  * Ts_div_2);
 
   attitude.normalize ();
 
   attitude.get_rotation_matrix (body2nav);
 
   acceleration_nav_frame = body2nav * acc;
-  induction_nav_frame 	 = body2nav * mag;
-  euler = attitude;
+  body_induction = mag; // NAV induction and euler angles on demand only
+  euler_valid = false;
+  induction_cache_valid = false;
 
   float3vector nav_rotation;
   nav_rotation = body2nav * gyro;
@@ -208,12 +234,12 @@ AHRS_type::update_attitude ( const float3vector &acc,
   slip_angle_averager.respond( ATAN2( -acc[RIGHT], -acc[DOWN]));
   pitch_angle_averager.respond( ATAN2( +acc[FRONT], -acc[DOWN]));
   G_load_averager.respond( acc.abs());
-  magnetic_disturbance = (induction_nav_frame - expected_nav_induction).abs();
 }
 
 /**
  * @brief  update attitude from IMU data D-GNSS compass
  */
+template< class circling_aiding>
 void
 AHRS_type::update_diff_GNSS (const float3vector &gyro,
 			     const float3vector &acc,
@@ -232,11 +258,12 @@ AHRS_type::update_diff_GNSS (const float3vector &gyro,
 
   float3vector nav_acceleration = body2nav * acc;
 
+  eulerangle<ftype> present_euler = get_euler();
   float heading_gnss_work = GNSS_heading	// correct for antenna alignment
-      + antenna_DOWN_correction  * SIN (euler.r)
-      - antenna_RIGHT_correction * COS (euler.r);
+      + antenna_DOWN_correction  * SIN (present_euler.r)
+      - antenna_RIGHT_correction * COS (present_euler.r);
 
-  heading_gnss_work = heading_gnss_work - euler.y; // = heading difference D-GNSS - AHRS
+  heading_gnss_work = heading_gnss_work - present_euler.y; // = heading difference D-GNSS - AHRS
 
   if (heading_gnss_work > M_PI_F) // map into { -PI PI}
     heading_gnss_work -= 2.0f * M_PI_F;
@@ -254,16 +281,16 @@ AHRS_type::update_diff_GNSS (const float3vector &gyro,
 
   if( circling_state == CIRCLING) // heading correction using acceleration cross product GNSS * INS
     {
-
-#if USE_ACCELERATION_CROSS_GAIN_ALONE_WHEN_CIRCLING
-      nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN; // no MAG or D-GNSS use here !
-#else
-      float3vector nav_induction    = body2nav * mag;
-      float mag_correction =
-    	+ nav_induction[NORTH] * expected_nav_induction[EAST]
-    	- nav_induction[EAST]  * expected_nav_induction[NORTH];
-      nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN + mag_correction * magnetic_control_gain ; // use X-ACC and MAG: better !
-#endif
+      if( ! circling_aiding::USE_INDUCTION)
+	nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN; // no MAG or D-GNSS use here !
+      else
+	{
+	  float3vector nav_induction    = body2nav * mag;
+	  float mag_correction =
+	    + nav_induction[NORTH] * expected_nav_induction[EAST]
+	    - nav_induction[EAST]  * expected_nav_induction[NORTH];
+	  nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN + mag_correction * magnetic_control_gain ; // use X-ACC and MAG: better !
+	}
     }
   else
       nav_correction[DOWN]  =   heading_gnss_work * H_GAIN;
@@ -282,6 +309,8 @@ AHRS_type::update_diff_GNSS (const float3vector &gyro,
   if ( (circling_state == CIRCLING) && ( nav_correction.abs() < NAV_CORRECTION_LIMIT))
 	feed_magnetic_induction_observer (mag_sensor);
 
+  continue_magnetic_calibration();
+
   // when circling is finished eventually update the magnetic calibration
   if (automatic_magnetic_calibration && (old_circle_state == CIRCLING) && (circling_state == TRANSITION))
 	  handle_magnetic_calibration ('s');
@@ -290,6 +319,7 @@ AHRS_type::update_diff_GNSS (const float3vector &gyro,
 /**
  * @brief  update attitude from IMU data and magnetometer
  */
+template< class circling_aiding>
 void
 AHRS_type::update_compass (const float3vector &gyro, const float3vector &acc,
 			   const float3vector &mag_sensor,
@@ -338,12 +368,11 @@ AHRS_type::update_compass (const float3vector &gyro, const float3vector &acc,
       // *******************************************************************************************************
     case CIRCLING:
       {
-#if USE_ACCELERATION_CROSS_GAIN_ALONE_WHEN_CIRCLING
-	    nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN; // no MAG or D-GNSS use here ! (old version)
-#else
-	nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN
+	if( ! circling_aiding::USE_INDUCTION)
+	  nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN; // no MAG or D-GNSS use here ! (old version)
+	else
+	  nav_correction[DOWN] = cross_acc_correction * CROSS_GAIN
 	    + mag_correction * M_H_GAIN; // use cross-acceleration and induction: better !
-#endif
 	gyro_correction = body2nav.reverse_map (nav_correction);
 	gyro_correction *= P_GAIN;
       }
@@ -360,11 +389,32 @@ AHRS_type::update_compass (const float3vector &gyro, const float3vector &acc,
   if ( (circling_state == CIRCLING) && ( nav_correction.abs() < NAV_CORRECTION_LIMIT))
 	feed_magnetic_induction_observer (mag_sensor);
 
+  continue_magnetic_calibration();
+
   // when circling is finished eventually update the magnetic calibration
   if (automatic_magnetic_calibration && (old_circle_state == CIRCLING) && (circling_state == TRANSITION))
 	  handle_magnetic_calibration('m');
 }
 
+void
+AHRS_type::update_compass (const float3vector &gyro, const float3vector &acc,
+			   const float3vector &mag_sensor,
+			   const float3vector &GNSS_acceleration)
+{
+  update_compass< default_circling_aiding> (gyro, acc, mag_sensor, GNSS_acceleration);
+}
+
+#if UNIX
+// all variants of the update kernel, to be compared side by side on the host,
+// the target uses the default ones only
+template void AHRS_type::update< compass_aiding,  cross_acc_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &, float, bool);
+template void AHRS_type::update< compass_aiding,  cross_acc_and_induction_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &, float, bool);
+template void AHRS_type::update< D_GNSS_aiding,   cross_acc_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &, float, bool);
+template void AHRS_type::update< D_GNSS_aiding,   cross_acc_and_induction_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &, float, bool);
+template void AHRS_type::update< ACC_only_aiding, cross_acc_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &, float, bool); // circling policy unused
+template void AHRS_type::update_compass< cross_acc_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &);
+template void AHRS_type::update_compass< cross_acc_and_induction_circling>( const float3vector &, const float3vector &, const float3vector &, const float3vector &);
+#endif
 
 /**
  * @brief  update attitude from IMU data NOT using magnetometer of D-GNSS
@@ -414,15 +464,27 @@ void AHRS_type::write_calibration_into_EEPROM( void)
 
   lock_EEPROM( false);
 
-  compass_calibration.write_into_EEPROM();
-  magnetic_calibration_updated = false; // done ...
+  if( ! compass_calibration.write_into_EEPROM())
+    magnetic_calibration_updated = false; // done ... otherwise try again next time
 
   lock_EEPROM( true);
 }
 
+/**
+ * @brief start magnetic calibration after circling
+ *
+ * The evaluation is spread over the following ticks,
+ * see continue_magnetic_calibration()
+ */
 void AHRS_type::handle_magnetic_calibration ( char type)
 {
-  bool calibration_changed = compass_calibration.set_calibration_if_changed ( mag_calibration_data_collector_right_turn, mag_calibration_data_collector_left_turn, MAG_SCALE);
+  magnetic_calibration_type = type;
+  if( compass_calibration.start_evaluation ( mag_calibration_data_collector_right_turn, mag_calibration_data_collector_left_turn, MAG_SCALE))
+    finish_magnetic_calibration( false); // not enough data, but maybe earth field information
+}
+
+void AHRS_type::finish_magnetic_calibration ( bool calibration_changed)
+{
 
   float induction_error = 0.0f;
 
@@ -440,6 +502,7 @@ void AHRS_type::handle_magnetic_calibration ( char type)
 	      expected_nav_induction = new_induction_estimate;
 	      expected_nav_induction.normalize();
 	      update_magnetic_loop_gain(); // adapt to magnetic inclination
+	      induction_cache_valid = false;
 
 	      calibration_changed = true;
 	    }
@@ -458,7 +521,7 @@ void AHRS_type::handle_magnetic_calibration ( char type)
       magnetic_induction_report.nav_induction_std_deviation = induction_error;
 #endif
 
-      report_magnetic_calibration_has_changed( &magnetic_induction_report, type);
+      report_magnetic_calibration_has_changed( &magnetic_induction_report, magnetic_calibration_type);
       magnetic_calibration_updated = true;
     }
 }
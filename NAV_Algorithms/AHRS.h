@@ -34,8 +34,8 @@
 #include "HP_LP_fusion.h"
 #include "induction_observer.h"
 #include "pt2.h"
-
-extern float3vector nav_induction;
+#include "system_configuration.h"
+#include "NAV_tuning_parameters.h"
 
 enum { ROLL, PITCH, YAW};
 enum { FRONT, RIGHT, BOTTOM};
@@ -45,6 +45,42 @@ typedef enum  { STRAIGHT_FLIGHT, TRANSITION, CIRCLING} circle_state_t;
 
 typedef integrator<float, float3vector> vector3integrator;
 
+//! sample type of the magnetic calibration statistics, see Linear_Least_Square_Fit.h
+#if USE_CENTERED_FLOAT_STATISTICS
+typedef centered_float mag_calibration_sample_type;
+#else
+typedef int64_t mag_calibration_sample_type;
+#endif
+
+/**
+ * @brief heading aiding strategies, template parameters of AHRS_type::update()
+ *
+ * Each combination with a circling policy gives its own specialized update kernel,
+ * all of them are instantiated in AHRS.cpp for the host.
+ * ACC_only_aiding never reaches the circling code, so the circling policy
+ * does not apply to it and only one of its variants is instantiated.
+ */
+struct compass_aiding	{ enum { USE_D_GNSS = 0, USE_COMPASS = 1 }; }; //!< magnetometer only
+struct D_GNSS_aiding	{ enum { USE_D_GNSS = 1, USE_COMPASS = 1 }; }; //!< D-GNSS heading if valid, magnetometer otherwise
+struct ACC_only_aiding	{ enum { USE_D_GNSS = 0, USE_COMPASS = 0 }; }; //!< acceleration cross product only (soft iron tests)
+
+//! heading correction while circling: acceleration cross product alone
+struct cross_acc_circling		{ enum { USE_INDUCTION = 0 }; };
+//! heading correction while circling: acceleration cross product + induction
+struct cross_acc_and_induction_circling	{ enum { USE_INDUCTION = 1 }; };
+
+#if DISABLE_SAT_COMPASS
+typedef compass_aiding default_heading_aiding;
+#else
+typedef D_GNSS_aiding default_heading_aiding;
+#endif
+
+#if USE_ACCELERATION_CROSS_GAIN_ALONE_WHEN_CIRCLING
+typedef cross_acc_circling default_circling_aiding;
+#else
+typedef cross_acc_and_induction_circling default_circling_aiding;
+#endif
+
 //! Attitude and heading reference system class
 class AHRS_type
 {
@@ -61,22 +97,51 @@ public:
 	  expected_nav_induction[EAST]  = COS( inclination) * SIN( declination);
 	  expected_nav_induction[DOWN]  = SIN( inclination);
 	  update_magnetic_loop_gain(); // adapt to magnetic inclination
+	  induction_cache_valid = false;
 	}
 
+	//! update using the default aiding strategies
 	void update( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
 		const float3vector &GNSS_acceleration,
 		float GNSS_heading,
 		bool GNSS_heading_valid
 		);
 
+	//! update using the given heading aiding and circling policies
+	template< class heading_aiding, class circling_aiding>
+	void update( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
+		const float3vector &GNSS_acceleration,
+		float GNSS_heading,
+		bool GNSS_heading_valid
+		);
+
+	/**
+	 * @brief use a coning correction for the next attitude update
+	 *
+	 * Given by coning_integrator_t when the gyro runs faster than Ts.
+	 * The next update then rotates by gyro * Ts + correction
+	 * using the exact quaternion formula. Effective for one update only.
+	 */
+	inline void set_coning_correction( const float3vector & correction)
+	{
+		coning_correction = correction;
+		coning_correction_pending = true;
+	}
+
 	inline void set_from_euler( float r, float n, float y)
 	{
 		attitude.from_euler( r, n, y);
 		attitude.get_rotation_matrix( body2nav);
-		euler = attitude;
+		euler_valid = false;
 	}
+	//! euler angles, computed on first read after an attitude change
 	inline eulerangle<ftype> get_euler(void) const
 	{
+		if( ! euler_valid)
+		  {
+		    euler = attitude;
+		    euler_valid = true;
+		  }
 		return euler;
 	}
 	inline quaternion<ftype> get_attitude(void) const
@@ -89,6 +154,7 @@ public:
 	}
 	inline const float3vector &get_nav_induction(void) const
 	{
+		update_induction_cache();
 		return induction_nav_frame;
 	}
 	inline float get_lin_e0(void) const
@@ -172,11 +238,13 @@ public:
   void update_compass(
 		  const float3vector &gyro, const float3vector &acc, const float3vector &mag,
 		  const float3vector &GNSS_acceleration); //!< rotate quaternion taking angular rate readings
-#if 1 // SOFT_IRON_TEST
+  template< class circling_aiding>
+  void update_compass(
+		  const float3vector &gyro, const float3vector &acc, const float3vector &mag,
+		  const float3vector &GNSS_acceleration);
   void update_ACC_only(
 		  const float3vector &gyro, const float3vector &acc, const float3vector &mag,
 		  const float3vector &GNSS_acceleration); //!< rotate quaternion taking angular rate readings
-#endif
   float
   getHeadingDifferenceAhrsDgnss () const
   {
@@ -185,11 +253,33 @@ public:
 
   float getMagneticDisturbance () const
   {
+    update_induction_cache();
     return magnetic_disturbance;
   }
 
 private:
+  //! NAV induction and disturbance, computed on first read after an attitude change
+  void update_induction_cache( void) const
+  {
+    if( induction_cache_valid)
+      return;
+    induction_nav_frame  = body2nav * body_induction;
+    magnetic_disturbance = (induction_nav_frame - expected_nav_induction).abs();
+    induction_cache_valid = true;
+  }
+
   void handle_magnetic_calibration( char type);
+  void finish_magnetic_calibration( bool calibration_changed);
+
+  //! evaluate one more axis of a pending magnetic calibration
+  void continue_magnetic_calibration( void)
+  {
+    if( ! compass_calibration.is_evaluation_pending())
+      return;
+    bool calibration_changed = compass_calibration.evaluation_step();
+    if( ! compass_calibration.is_evaluation_pending())
+      finish_magnetic_calibration( calibration_changed);
+  }
 
   void update_magnetic_loop_gain( void)
   {
@@ -203,6 +293,7 @@ private:
   void feed_magnetic_induction_observer(const float3vector &mag_sensor);
   circle_state_t update_circling_state( void);
 
+  template< class circling_aiding>
   void update_diff_GNSS( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
 	  const float3vector &GNSS_acceleration,
 	  float GNSS_heading);
@@ -217,18 +308,20 @@ private:
   circle_state_t circling_state;
   float3vector nav_correction;
   float3vector gyro_correction;
+  float3vector coning_correction;	//!< from high-rate gyro integration, see set_coning_correction()
   float3vector acceleration_nav_frame;
-  float3vector induction_nav_frame; 	//!< observed NAV induction
+  mutable float3vector induction_nav_frame; //!< observed NAV induction, lazy
+  float3vector body_induction;		//!< calibrated induction of the last update
   float3vector expected_nav_induction;	//!< expected NAV induction
   float3matrix body2nav;
-  eulerangle<ftype> euler;
+  mutable eulerangle<ftype> euler;	//!< lazy, see get_euler()
   pt2<float,float> slip_angle_averager;
   pt2<float,float> pitch_angle_averager;
   pt2<float,float> turn_rate_averager;
   pt2<float,float> G_load_averager;
-  linear_least_square_fit<int64_t, float> mag_calibration_data_collector_right_turn[3];
-  linear_least_square_fit<int64_t, float> mag_calibration_data_collector_left_turn[3];
-  compass_calibration_t <int64_t, float> compass_calibration;
+  linear_least_square_fit<mag_calibration_sample_type, float> mag_calibration_data_collector_right_turn[3];
+  linear_least_square_fit<mag_calibration_sample_type, float> mag_calibration_data_collector_left_turn[3];
+  compass_calibration_t <mag_calibration_sample_type, float> compass_calibration;
 #if USE_EARTH_INDUCTION_DATA_COLLECTOR
   induction_observer_t <int64_t> earth_induction_data_collector;
 #endif
@@ -236,11 +329,15 @@ private:
   float antenna_RIGHT_correction; //!< slave antenna more right / DGNSS base length
   float heading_difference_AHRS_DGNSS;
   float cross_acc_correction;
-  float magnetic_disturbance; //!< abs( observed_induction - expected_induction)
+  mutable float magnetic_disturbance; //!< abs( observed_induction - expected_induction), lazy
   float magnetic_control_gain; //!< declination-dependent magnetic control loop gain
   bool automatic_magnetic_calibration;
   bool automatic_earth_field_parameters; // todo unused, remove me some day
   bool magnetic_calibration_updated;
+  char magnetic_calibration_type;	//!< 's' = D-GNSS or 'm' = magnetic, for the calibration report
+  mutable bool euler_valid;		//!< euler is up to date
+  mutable bool induction_cache_valid;	//!< induction_nav_frame and magnetic_disturbance are up to date
+  bool coning_correction_pending;	//!< use coning_correction on next update
 };
 
 #endif /* AHRS_H_ */
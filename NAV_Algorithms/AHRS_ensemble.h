@@ -0,0 +1,411 @@
+/***********************************************************************//**
+ * @file		AHRS_ensemble.h
+ * @brief		lock-step AHRS instances with individual controller gains
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef AHRS_ENSEMBLE_H_
+#define AHRS_ENSEMBLE_H_
+
+#include "system_configuration.h"
+#include "embedded_math.h"
+#include "AHRS.h"
+#include "quaternion_batch.h"
+#include "float3vector_batch.h"
+#include "float3matrix_batch.h"
+#include "NAV_tuning_parameters.h"
+
+//! attitude controller gains, defaults from NAV_tuning_parameters.h
+typedef struct
+{
+  float P;	//!< proportional gain
+  float I;	//!< integral gain
+  float H;	//!< D-GNSS heading gain
+  float CROSS;	//!< cross-product gain
+  float M_H;	//!< magnetic heading gain
+} AHRS_gains_t;
+
+inline AHRS_gains_t default_AHRS_gains( void)
+{
+  AHRS_gains_t gains = { P_GAIN, I_GAIN, H_GAIN, CROSS_GAIN, M_H_GAIN};
+  return gains;
+}
+
+/**
+ * @brief K attitude and heading reference systems running in lock-step
+ *
+ * All instances see the same sensor data, but each one uses its own
+ * controller gains. The state is kept in structure-of-arrays form, so one
+ * pass over a recorded flight evaluates K parameter sets at once.
+ * The algorithm follows AHRS_type::update_compass() and
+ * AHRS_type::update_diff_GNSS(), magnetic auto-calibration is not
+ * performed: the compass calibration is taken from the configuration.
+ * The aiding policies are those of AHRS_type, ACC_only_aiding is not available.
+ */
+template <int K> class AHRS_ensemble
+{
+public:
+  AHRS_ensemble( float sampling_time)
+  : Ts_div_2( sampling_time / 2.0f),
+    turn_rate_averager( ANGLE_F_BY_FS),
+    antenna_DOWN_correction(  configuration( ANT_SLAVE_DOWN)  / configuration( ANT_BASELENGTH)),
+    antenna_RIGHT_correction( configuration( ANT_SLAVE_RIGHT) / configuration( ANT_BASELENGTH))
+  {
+    for( int i = 0; i < K; ++i)
+      {
+	set_gains( i, default_AHRS_gains());
+	circling_counter[i] = 0;
+	circling_state[i] = STRAIGHT_FLIGHT;
+	cross_acc_correction[i] = ZERO;
+	heading_difference_AHRS_DGNSS[i] = ZERO;
+      }
+
+    bool fail = compass_calibration.read_from_EEPROM();
+    if( fail)
+      compass_calibration.set_default();
+  }
+
+  void set_gains( int instance, const AHRS_gains_t & _gains)
+  {
+    gains[instance] = _gains;
+    update_magnetic_loop_gain( instance);
+  }
+  const AHRS_gains_t & get_gains( int instance) const
+  {
+    return gains[instance];
+  }
+
+  //! initial attitude setup from observables, see AHRS_type::attitude_setup()
+  void attitude_setup( const float3vector & acceleration, const float3vector & mag);
+
+  void update_magnetic_induction_data( float declination, float inclination)
+  {
+    declination *= (M_PI_F / 180.0f); // degrees to radiant
+    inclination *= (M_PI_F / 180.0f);
+
+    expected_nav_induction[NORTH] = COS( inclination);
+    expected_nav_induction[EAST]  = COS( inclination) * SIN( declination);
+    expected_nav_induction[DOWN]  = SIN( inclination);
+    for( int i = 0; i < K; ++i)
+      update_magnetic_loop_gain( i);
+  }
+
+  //! update using the default aiding strategies
+  void update( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
+	  const float3vector &GNSS_acceleration,
+	  float GNSS_heading,
+	  bool GNSS_heading_valid)
+  {
+    update< default_heading_aiding, default_circling_aiding>( gyro, acc, mag, GNSS_acceleration, GNSS_heading, GNSS_heading_valid);
+  }
+
+  //! update using the given heading aiding and circling policies, see AHRS.h
+  template< class heading_aiding, class circling_aiding>
+  void update( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
+	  const float3vector &GNSS_acceleration,
+	  float GNSS_heading,
+	  bool GNSS_heading_valid)
+  {
+    static_assert( heading_aiding::USE_COMPASS, "ACC_only_aiding is not implemented for the ensemble");
+    if( heading_aiding::USE_D_GNSS && GNSS_heading_valid)
+      update_diff_GNSS< circling_aiding>( gyro, acc, mag, GNSS_acceleration, GNSS_heading);
+    else
+      update_compass< circling_aiding>( gyro, acc, mag, GNSS_acceleration);
+  }
+
+  quaternion<float> get_attitude( int instance) const
+  {
+    return attitude.get( instance);
+  }
+  eulerangle<float> get_euler( int instance) const
+  {
+    return attitude.get( instance);
+  }
+  circle_state_t get_circling_state( int instance) const
+  {
+    return circling_state[instance];
+  }
+  float get_heading_difference_AHRS_DGNSS( int instance) const
+  {
+    return heading_difference_AHRS_DGNSS[instance];
+  }
+  float get_cross_acc_correction( int instance) const
+  {
+    return cross_acc_correction[instance];
+  }
+
+private:
+  void update_magnetic_loop_gain( int i)
+  {
+    float expected_horizontal_induction = SQRT( SQR(expected_nav_induction[EAST])+SQR(expected_nav_induction[NORTH]));
+    if( expected_horizontal_induction < 0.001f) // fail-safe default
+      magnetic_control_gain[i] = gains[i].M_H;
+    else
+      magnetic_control_gain[i] = gains[i].M_H / expected_horizontal_induction;
+  }
+
+  //! transform one body-frame vector with all rotation matrices
+  void map_to_nav( const float3vector & body, float3vector_batch<K> & nav) const
+  {
+    for( int row = 0; row < 3; ++row)
+      for( int i = 0; i < K; ++i)
+	nav.e[row][i] =   body2nav.e[row][0][i] * body[0]
+			+ body2nav.e[row][1][i] * body[1]
+			+ body2nav.e[row][2][i] * body[2];
+  }
+
+  float3vector calibrate( const float3vector & mag_sensor)
+  {
+    if( compass_calibration.isCalibrationDone()) // use calibration if available
+      return compass_calibration.calibrate( mag_sensor);
+    return mag_sensor;
+  }
+
+  void update_circling_state( void);
+  template< class circling_aiding>
+  void update_compass( const float3vector &gyro, const float3vector &acc, const float3vector &mag_sensor,
+	  const float3vector &GNSS_acceleration);
+  template< class circling_aiding>
+  void update_diff_GNSS( const float3vector &gyro, const float3vector &acc, const float3vector &mag_sensor,
+	  const float3vector &GNSS_acceleration, float GNSS_heading);
+  void apply_correction( const float3vector &gyro, circle_state_t integrating_state);
+
+  float Ts_div_2;
+  AHRS_gains_t gains[K];
+  float magnetic_control_gain[K];
+  quaternion_batch<K> attitude;
+  float3matrix_batch<K> body2nav;
+  float3vector_batch<K> gyro_integrator;
+  float3vector_batch<K> nav_correction;
+  float3vector_batch<K> gyro_correction;
+  float3vector_batch<K> nav_acceleration;
+  float3vector_batch<K> nav_induction;
+  pt2< vector<float, K>, float> turn_rate_averager;
+  unsigned circling_counter[K];
+  circle_state_t circling_state[K];
+  float cross_acc_correction[K];
+  float heading_difference_AHRS_DGNSS[K];
+  float3vector expected_nav_induction;
+  compass_calibration_t <mag_calibration_sample_type, float> compass_calibration;
+  float antenna_DOWN_correction;  //!< slave antenna lower / DGNSS base length
+  float antenna_RIGHT_correction; //!< slave antenna more right / DGNSS base length
+};
+
+template <int K>
+void AHRS_ensemble<K>::attitude_setup( const float3vector & acceleration, const float3vector & mag)
+{
+  float3vector north, east, down;
+  float3vector induction = calibrate( mag);
+
+  down = acceleration;
+  down.negate ();
+  down.normalize ();
+
+  north = induction; // deviation neglected here
+  north.normalize ();
+
+  // setup world coordinate system
+  east = down.vector_multiply (north);
+  east.normalize ();
+  north = east.vector_multiply (down);
+  north.normalize ();
+
+  float fcoordinates[] =
+    { 	north[0], north[1], north[2],
+	east[0], east[1], east[2],
+	down[0], down[1], down[2] };
+
+  float3matrix coordinates (fcoordinates);
+  quaternion<float> q;
+  q.from_rotation_matrix( coordinates);
+  for( int i = 0; i < K; ++i)
+    attitude.set( i, q);
+  attitude.get_rotation_matrix( body2nav);
+}
+
+template <int K>
+void AHRS_ensemble<K>::update_circling_state( void)
+{
+  vector<float, K> turn_rate = turn_rate_averager.get_output();
+  for( int i = 0; i < K; ++i)
+    {
+#if DISABLE_CIRCLING_STATE
+      circling_state[i] = STRAIGHT_FLIGHT;
+#else
+      float turn_rate_abs = abs( turn_rate[i]);
+
+      if (circling_counter[i] < CIRCLE_LIMIT)
+	if (turn_rate_abs > HIGH_TURN_RATE)
+	  ++circling_counter[i];
+
+      if (circling_counter[i] > 0)
+	if (turn_rate_abs < LOW_TURN_RATE)
+	  --circling_counter[i];
+
+      if (circling_counter[i] == 0)
+	circling_state[i] = STRAIGHT_FLIGHT;
+      else if (circling_counter[i] == CIRCLE_LIMIT)
+	circling_state[i] = CIRCLING;
+      else
+	circling_state[i] = TRANSITION;
+#endif
+    }
+}
+
+/**
+ * @brief common tail of the update: controller output and quaternion update
+ * @param integrating_state integrator runs unless state == CIRCLING (compass)
+ *        or only in STRAIGHT_FLIGHT (D-GNSS)
+ */
+template <int K>
+void AHRS_ensemble<K>::apply_correction( const float3vector &gyro, circle_state_t integrating_state)
+{
+  body2nav.reverse_map( nav_correction, gyro_correction);
+
+  for( int k = 0; k < 3; ++k)
+    for( int i = 0; i < K; ++i)
+      {
+	gyro_correction.e[k][i] *= gains[i].P;
+	bool integrate = (integrating_state == STRAIGHT_FLIGHT)
+	    ? (circling_state[i] == STRAIGHT_FLIGHT)
+	    : (circling_state[i] != CIRCLING);
+	if( integrate)
+	  gyro_integrator.e[k][i] += gyro_correction.e[k][i];
+	gyro_correction.e[k][i] = gyro_correction.e[k][i] + gyro_integrator.e[k][i] * gains[i].I;
+      }
+
+  float3vector_batch<K> rotation; // corrected gyro readings
+  for( int k = 0; k < 3; ++k)
+    for( int i = 0; i < K; ++i)
+      rotation.e[k][i] = gyro[k] + gyro_correction.e[k][i];
+
+  float3vector_batch<K> delta = rotation;
+  delta *= Ts_div_2;
+  attitude.rotate( delta);
+  attitude.normalize();
+  attitude.get_rotation_matrix( body2nav);
+
+  vector<float, K> nav_rotation_down;
+  for( int i = 0; i < K; ++i)
+    nav_rotation_down[i] =    body2nav.e[DOWN][0][i] * rotation.e[0][i]
+			    + body2nav.e[DOWN][1][i] * rotation.e[1][i]
+			    + body2nav.e[DOWN][2][i] * rotation.e[2][i];
+  turn_rate_averager.respond( nav_rotation_down);
+}
+
+template <int K>
+template< class circling_aiding>
+void AHRS_ensemble<K>::update_compass( const float3vector &gyro, const float3vector &acc,
+				       const float3vector &mag_sensor,
+				       const float3vector &GNSS_acceleration)
+{
+  float3vector mag = calibrate( mag_sensor);
+  map_to_nav( acc, nav_acceleration);
+  map_to_nav( mag, nav_induction);
+
+  update_circling_state();
+
+  for( int i = 0; i < K; ++i)
+    {
+      nav_correction.e[NORTH][i] = -nav_acceleration.e[EAST][i] + GNSS_acceleration[EAST];
+      nav_correction.e[EAST][i]  = +nav_acceleration.e[NORTH][i] - GNSS_acceleration[NORTH];
+
+      float mag_correction =
+	  + nav_induction.e[NORTH][i] * expected_nav_induction[EAST]
+	  - nav_induction.e[EAST][i]  * expected_nav_induction[NORTH];
+
+      cross_acc_correction[i] = // vector cross product GNSS-acc und INS-acc -> heading error
+	  + nav_acceleration.e[NORTH][i] * GNSS_acceleration[EAST]
+	  - nav_acceleration.e[EAST][i]  * GNSS_acceleration[NORTH];
+
+      if( circling_state[i] != CIRCLING)
+	nav_correction.e[DOWN][i] = magnetic_control_gain[i] * mag_correction;
+      else if( ! circling_aiding::USE_INDUCTION)
+	nav_correction.e[DOWN][i] = cross_acc_correction[i] * gains[i].CROSS;
+      else
+	nav_correction.e[DOWN][i] = cross_acc_correction[i] * gains[i].CROSS + mag_correction * gains[i].M_H;
+    }
+
+  apply_correction( gyro, TRANSITION);
+}
+
+template <int K>
+template< class circling_aiding>
+void AHRS_ensemble<K>::update_diff_GNSS( const float3vector &gyro, const float3vector &acc,
+					 const float3vector &mag_sensor,
+					 const float3vector &GNSS_acceleration,
+					 float GNSS_heading)
+{
+  update_circling_state();
+
+  map_to_nav( acc, nav_acceleration);
+  if( circling_aiding::USE_INDUCTION)
+    map_to_nav( calibrate( mag_sensor), nav_induction);
+
+  for( int i = 0; i < K; ++i)
+    {
+      float e0 = attitude.e[0][i];
+      float e1 = attitude.e[1][i];
+      float e2 = attitude.e[2][i];
+      float e3 = attitude.e[3][i];
+      float roll = ATAN2( TWO * (e0*e1 + e2*e3) , e0*e0 - e1*e1 - e2*e2 + e3*e3 );
+      float yaw  = ATAN2( TWO * (e0*e3 + e1*e2) , e0*e0 + e1*e1 - e2*e2 - e3*e3 );
+
+      float heading_gnss_work = GNSS_heading	// correct for antenna alignment
+	  + antenna_DOWN_correction  * SIN( roll)
+	  - antenna_RIGHT_correction * COS( roll);
+
+      heading_gnss_work = heading_gnss_work - yaw; // = heading difference D-GNSS - AHRS
+
+      if (heading_gnss_work > M_PI_F) // map into { -PI PI}
+	heading_gnss_work -= 2.0f * M_PI_F;
+      if (heading_gnss_work < -M_PI_F)
+	heading_gnss_work += 2.0f * M_PI_F;
+
+      heading_difference_AHRS_DGNSS[i] = heading_gnss_work;
+
+      nav_correction.e[NORTH][i] = - nav_acceleration.e[EAST][i]  + GNSS_acceleration[EAST];
+      nav_correction.e[EAST][i]  = + nav_acceleration.e[NORTH][i] - GNSS_acceleration[NORTH];
+
+      cross_acc_correction[i] = // vector cross product GNSS-acc und INS-acc -> heading error
+	  + nav_acceleration.e[NORTH][i] * GNSS_acceleration[EAST]
+	  - nav_acceleration.e[EAST][i]  * GNSS_acceleration[NORTH];
+
+      if( circling_state[i] == CIRCLING)
+	{
+	  if( ! circling_aiding::USE_INDUCTION)
+	    nav_correction.e[DOWN][i] = cross_acc_correction[i] * gains[i].CROSS;
+	  else
+	    {
+	      float mag_correction =
+		  + nav_induction.e[NORTH][i] * expected_nav_induction[EAST]
+		  - nav_induction.e[EAST][i]  * expected_nav_induction[NORTH];
+	      nav_correction.e[DOWN][i] = cross_acc_correction[i] * gains[i].CROSS + mag_correction * magnetic_control_gain[i];
+	    }
+	}
+      else
+	nav_correction.e[DOWN][i] = heading_gnss_work * gains[i].H;
+    }
+
+  apply_correction( gyro, STRAIGHT_FLIGHT);
+}
+
+#endif /* AHRS_ENSEMBLE_H_ */
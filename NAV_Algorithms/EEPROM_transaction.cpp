@@ -0,0 +1,83 @@
+/***********************************************************************//**
+ * @file		EEPROM_transaction.cpp
+ * @brief		write several EEPROM parameters as one atomic transaction
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "EEPROM_transaction.h"
+
+bool EEPROM_transaction_t::stage( EEPROM_PARAMETER_ID new_id, float new_value)
+{
+  for( unsigned i = 0; i < count; ++i)
+    if( id[i] == new_id)
+      {
+	value[i] = new_value;
+	return false;
+      }
+
+  if( count >= EEPROM_TRANSACTION_ENTRIES)
+    return true;
+
+  id[count] = new_id;
+  value[count] = new_value;
+  ++count;
+  return false;
+}
+
+bool EEPROM_transaction_t::commit( void)
+{
+  if( count == 0)
+    return false;
+
+  unsigned staged = count;
+  count = 0; // the transaction is gone, whatever happens now
+
+  uint16_t selector = read_EEPROM_selector();
+  uint16_t groups = 0;
+
+  for( unsigned i = 0; i < staged; ++i)
+    {
+      groups |= (uint16_t)( 1 << ( id[i] / EEPROM_GROUP_SIZE));
+      if( write_EEPROM_slot( id[i], value[i], ! EEPROM_uses_slot_B( selector, id[i])))
+	return true; // nothing taken yet
+    }
+
+  // the remaining parameters of these groups move to the new slot unchanged,
+  // a missing one gets its default, never what an interrupted commit left there
+  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < PERSISTENT_DATA + PERSISTENT_DATA_ENTRIES; ++parameter)
+    {
+      if( ( groups & ( 1 << ( parameter->id / EEPROM_GROUP_SIZE))) == 0)
+	continue;
+
+      bool is_staged = false;
+      for( unsigned i = 0; i < staged; ++i)
+	if( id[i] == parameter->id)
+	  is_staged = true;
+      if( is_staged)
+	continue;
+
+      if( copy_EEPROM_slot( parameter->id, ! EEPROM_uses_slot_B( selector, parameter->id), parameter->default_value))
+	return true;
+    }
+
+  return write_EEPROM_selector( selector ^ groups); // commit point
+}
@@ -0,0 +1,67 @@
+/***********************************************************************//**
+ * @file		EEPROM_transaction.h
+ * @brief		write several EEPROM parameters as one atomic transaction
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef EEPROM_TRANSACTION_H_
+#define EEPROM_TRANSACTION_H_
+
+#include "persistent_data.h"
+
+/**
+ * @brief stage parameter updates in RAM and commit them together
+ *
+ * commit() writes the staged values into the unused slots of their
+ * parameter groups, see EEPROM_SLOT_B_BASE, together with a copy of every other
+ * parameter of these groups, its default value if it is missing.
+ * Writing the selector word is the commit point, it makes the new slots valid.
+ * If power fails before, the old slots remain in use,
+ * so either all or none of the values are taken and no recovery is needed at boot.
+ *
+ * The EEPROM must be unlocked by the caller, like for write_EEPROM_value().
+ */
+class EEPROM_transaction_t
+{
+public:
+  EEPROM_transaction_t( void)
+  : count( 0)
+  {}
+
+  //! stage one value, a parameter staged twice keeps the last value
+  //! @return true on error (transaction full)
+  bool stage( EEPROM_PARAMETER_ID id, float value);
+
+  //! write all staged values, @return true on error
+  bool commit( void);
+
+  unsigned get_count( void) const
+  {
+    return count;
+  }
+
+private:
+  EEPROM_PARAMETER_ID id[EEPROM_TRANSACTION_ENTRIES];
+  float value[EEPROM_TRANSACTION_ENTRIES];
+  unsigned count;
+};
+
+#endif /* EEPROM_TRANSACTION_H_ */
@@ -29,6 +29,49 @@
 #include "embedded_math.h"
 #include <stdint.h>
 #include "system_configuration.h"
+#include "steady_state_kalman.h"
+
+/**
+ * @brief system model and noise specification
+ *
+ * Continuous white-jerk process noise as in Filter_Design/Kalman_XVA_acc_offset.m,
+ * measurements: altitude with 0.25 m, acceleration with 0.3 m/s^2 standard deviation.
+ */
+template< unsigned sampling_frequency> struct KalmanVario_design
+{
+  enum { N = 4, L = 2 };
+
+  static constexpr steady_state_kalman_model<N,L> model( void)
+  {
+    const double T = 1.0 / sampling_frequency; // sampling time
+    const double vpa   = 1.0;    // acceleration process variance / (m/s^2)^2
+    const double vaoff = 9.0e-6; // acceleration offset process variance
+
+    return steady_state_kalman_model<N,L>
+      {
+	{ // A
+	    { 1.0, T,   T * T / 2.0, 0.0 },
+	    { 0.0, 1.0, T,           0.0 },
+	    { 0.0, 0.0, 1.0,         0.0 },
+	    { 0.0, 0.0, 0.0,         1.0 }
+	},
+	{ // C
+	    { 1.0, 0.0, 0.0, 0.0 },
+	    { 0.0, 0.0, 1.0, 1.0 }
+	},
+	{ // Q
+	    { T*T*T*T*T / 20.0 * vpa, T*T*T*T / 8.0 * vpa, T*T*T / 6.0 * vpa, 0.0 },
+	    { T*T*T*T / 8.0 * vpa,    T*T*T / 3.0 * vpa,   T*T / 2.0 * vpa,   0.0 },
+	    { T*T*T / 6.0 * vpa,      T*T / 2.0 * vpa,     T * vpa,           0.0 },
+	    { 0.0,                    0.0,                 0.0,               vaoff }
+	},
+	{ // R
+	    { 0.25 * 0.25, 0.0 },
+	    { 0.0,         0.3 * 0.3 }
+	}
+      };
+  }
+};
 
 /**
  * @brief Kalman-filter-based sensor fusion observer for variometer
@@ -46,12 +89,9 @@ private:
     N = 4,  //!< size of state vector x = { altitude, vario, vertical-acceleration, acceleration-offset }
     L = 2  //!< number of measurement channels = { altitude, vertical_acceleration_measurement }
   };
-  static constexpr float Ta = 0.01f; 			//!< sampling rate
-  static constexpr float Ta_s_2 = Ta * Ta / 2.0f; 	//!< sampling rate
-  static ROM float Gain[N][L];				//!< Pre-computed Kalman Gain
 
   // variables
-  float x[N];	//!< state vector: altitude, vario, acceleration, acceleration offset
+  steady_state_kalman< KalmanVario_design< 100> > filter;	//!< state vector: altitude, vario, acceleration, acceleration offset
 
 public:
   typedef enum// state vector components
@@ -60,15 +100,19 @@ public:
   }  state;
 
   KalmanVario_t ( float _x=ZERO, float v=ZERO, float a=ZERO, float a_offset=ZERO)
-    : x{_x, v, a, a_offset}
-  {}
+  {
+    filter.set_x( ALTITUDE, _x);
+    filter.set_x( VARIO, v);
+    filter.set_x( ACCELERATION_OBSERVED, a);
+    filter.set_x( ACCELERATION_OFFSET, a_offset);
+  }
 
   void reset(  const float altitude, const float acceleration_offset)
   {
-    x[0] = altitude;
-    x[1] = 0.0f;
-    x[2] = 0.0f;
-    x[3] = acceleration_offset;
+    filter.set_x( ALTITUDE, altitude);
+    filter.set_x( VARIO, 0.0f);
+    filter.set_x( ACCELERATION_OBSERVED, 0.0f);
+    filter.set_x( ACCELERATION_OFFSET, acceleration_offset);
   }
 
   float update( const float altitude, const float acceleration);
@@ -76,9 +120,9 @@ public:
   inline float get_x( state index) const
   {
     if( index <= ACCELERATION_OFFSET)
-      return x[index];
+      return filter.get_x( index);
     else
-      return x[ACCELERATION_OBSERVED] + x[ACCELERATION_OFFSET]; // = acceleration minus offset
+      return filter.get_x( ACCELERATION_OBSERVED) + filter.get_x( ACCELERATION_OFFSET); // = acceleration minus offset
   };
 };
 
@@ -29,6 +29,42 @@
 #include "embedded_math.h"
 #include <stdint.h>
 #include "system_configuration.h"
+#include "steady_state_kalman.h"
+
+//! system model and noise specification, see Filter_Design/Kalman_VA_acc_offset.m
+template< unsigned sampling_frequency> struct Kalman_V_A_Aoff_observer_design
+{
+  enum { N = 3, L = 2 };
+
+  static constexpr steady_state_kalman_model<N,L> model( void)
+  {
+    const double T = 1.0 / sampling_frequency; // sampling time
+    const double vpa   = 3.0 * 3.0; // acceleration process variance / (m/s^2)^2
+    const double vaoff = 0.0001;    // acceleration offset process variance
+
+    return steady_state_kalman_model<N,L>
+      {
+	{ // A
+	    { 1.0, T,   0.0 },
+	    { 0.0, 1.0, 0.0 },
+	    { 0.0, 0.0, 1.0 }
+	},
+	{ // C
+	    { 1.0, 0.0, 0.0 },
+	    { 0.0, 1.0, 1.0 }
+	},
+	{ // Q
+	    { T*T*T / 3.0 * vpa, T*T / 2.0 * vpa, 0.0 },
+	    { T*T / 2.0 * vpa,   T * vpa,         0.0 },
+	    { 0.0,               0.0,             vaoff }
+	},
+	{ // R
+	    { 0.1 * 0.1, 0.0 },
+	    { 0.0,       0.1 * 0.1 }
+	}
+      };
+  }
+};
 
 /**
  * @brief Kalman-filter-based sensor fusion observer for horizontal movement
@@ -46,11 +82,9 @@ private:
     N = 3,  //!< size of state vector x = { altitude, vario, vertical-acceleration, acceleration-offset }
     L = 2  //!< number of measurement channels = { altitude, vertical_acceleration_measurement }
   };
-  static constexpr float Ta = 0.01f; 			//!< sampling rate
-  static ROM float Gain[N][L];				//!< Pre-computed Kalman Gain
 
   // variables
-  float x[N];	//!< state vector: altitude, vario, acceleration, acceleration offset
+  steady_state_kalman< Kalman_V_A_Aoff_observer_design< 100> > filter;	//!< state vector: altitude, vario, acceleration, acceleration offset
 
 public:
   typedef enum// state vector components
@@ -59,14 +93,16 @@ public:
   }  state;
 
   Kalman_V_A_Aoff_observer_t ( float v=ZERO, float a=ZERO)
-    : x{ v, a, 0.0f}
-  {}
+  {
+    filter.set_x( VELOCITY, v);
+    filter.set_x( ACCELERATION, a);
+  }
 
   void update( const float velocity, const float acceleration);
 
   inline float get_x( state index) const
   {
-      return x[index];
+      return filter.get_x( index);
   };
 };
 
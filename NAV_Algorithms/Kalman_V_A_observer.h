@@ -29,6 +29,45 @@
 #include "embedded_math.h"
 #include <stdint.h>
 #include "system_configuration.h"
+#include "steady_state_kalman.h"
+
+/**
+ * @brief system model and noise specification
+ *
+ * From Filter_Design/Kalman_VA_tuner.m. Its Q lacks the vpa factor in two places
+ * and is not symmetric, the symmetric part is used here.
+ */
+template< unsigned sampling_frequency> struct Kalman_V_A_observer_design
+{
+  enum { N = 2, L = 2 };
+
+  static constexpr steady_state_kalman_model<N,L> model( void)
+  {
+    const double T = 1.0 / sampling_frequency; // sampling time
+    const double vpa = 9.0; // acceleration process variance / (m/s^2)^2
+    const double Q_01 = ( T*T*T*T / 8.0 * vpa + T*T*T*T / 8.0) / 2.0;
+
+    return steady_state_kalman_model<N,L>
+      {
+	{ // A
+	    { 1.0, T   },
+	    { 0.0, 1.0 }
+	},
+	{ // C
+	    { 1.0, 0.0 },
+	    { 0.0, 1.0 }
+	},
+	{ // Q
+	    { T*T*T*T*T / 20.0 * vpa, Q_01 },
+	    { Q_01,                   T*T*T / 3.0 }
+	},
+	{ // R
+	    { 0.2 * 0.2, 0.0 },
+	    { 0.0,       0.05 * 0.05 }
+	}
+      };
+  }
+};
 
 /**
  * @brief Kalman-filter-based sensor fusion observer for horizontal movement
@@ -46,11 +85,9 @@ private:
     N = 2,  //!< size of state vector x = { altitude, vario, vertical-acceleration, acceleration-offset }
     L = 2  //!< number of measurement channels = { altitude, vertical_acceleration_measurement }
   };
-  static constexpr float Ta = 0.01f; 			//!< sampling rate
-  static ROM float Gain[N][L];				//!< Pre-computed Kalman Gain
 
   // variables
-  float x[N];	//!< state vector: altitude, vario, acceleration, acceleration offset
+  steady_state_kalman< Kalman_V_A_observer_design< 100> > filter;	//!< state vector: altitude, vario, acceleration, acceleration offset
 
 public:
   typedef enum// state vector components
@@ -59,14 +96,16 @@ public:
   }  state;
 
   Kalman_V_A_observer_t ( float v=ZERO, float a=ZERO)
-    : x{ v, a}
-  {}
+  {
+    filter.set_x( VELOCITY, v);
+    filter.set_x( ACCELERATION, a);
+  }
 
   float update( const float velocity, const float acceleration);
 
   inline float get_x( state index) const
   {
-      return x[index];
+      return filter.get_x( index);
   };
 };
 
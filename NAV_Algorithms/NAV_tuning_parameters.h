@@ -65,6 +65,8 @@
 #define AIRBORNE_TRIGGER_SPEED		0.5f //!< speed-compensator vario value m/s
 
 #define MAG_SCALE			10000.0f //!< scale factor for high-precision integer statistics
+// keep 0 until PROFILE_MAG_STATISTICS has confirmed the gain on the target, see Benchmarks/bench_M4_cost_model.cpp
+#define USE_CENTERED_FLOAT_STATISTICS	0 //!< if 1: magnetic calibration and air density statistics in float, no int64 or double
 #define FAST_SAMPLING_REQUENCY 		100.0f
 #define FAST_SAMPLING_TIME 		0.01f
 #define SLOW_SAMPLING_REQUENCY 		10.0f
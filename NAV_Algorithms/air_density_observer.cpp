@@ -58,7 +58,8 @@ air_data_result air_density_observer::feed_metering( float pressure, float MSL_a
 
 //  Due to numeric effects, when using float the
 //  variance has been observed to be negative in some cases !
-//  Therefore using float this test can not be used.
+//  Therefore using float raw sums this test can not be used.
+//  The residual sum of centered_float is a sum of squares, never negative.
  assert( result.variance_slope > 0);
  assert( result.variance_offset > 0);
 
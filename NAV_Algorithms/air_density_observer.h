@@ -27,10 +27,16 @@
 
 #include "Linear_Least_Square_Fit.h"
 #include "trigger.h"
+#include "NAV_tuning_parameters.h"
 
-#define DENSITY_MEASURMENT_COLLECTS_INTEGER 1
+#define DENSITY_MEASURMENT_COLLECTS_INTEGER 1 // altitude in cm and pressure in Pa
+#if USE_CENTERED_FLOAT_STATISTICS
+typedef float evaluation_type;
+typedef centered_float measurement_type;
+#else
 typedef double evaluation_type;
 typedef uint64_t measurement_type;
+#endif
 
 #define MAX_ALLOWED_VARIANCE	1e-9
 #define MINIMUM_ALTITUDE_RANGE	300.0f
@@ -29,6 +29,7 @@
 #include "float3vector.h"
 #include "Linear_Least_Square_Fit.h"
 #include "persistent_data.h"
+#include "EEPROM_transaction.h"
 #include "NAV_tuning_parameters.h"
 
 //! maintain offset and slope data for one sensor axis
@@ -73,7 +74,10 @@ template <class sample_type, class evaluation_type> class compass_calibration_t
 {
 public:
   compass_calibration_t( void)
-    : calibration_done( false)
+    : calibration_done( false),
+      pending_scale_factor( 1.0f),
+      pending_step( 0),
+      evaluation_pending( false)
   {}
 
   float3vector calibrate( const float3vector &in)
@@ -105,35 +109,70 @@ public:
   }
 
 
-  bool set_calibration_if_changed(
+  /**
+   * @brief take over the collected data, to be evaluated by evaluation_step()
+   *
+   * The collectors are reset for new data.
+   * @return true if there is not enough data, nothing to do
+   */
+  bool start_evaluation(
       linear_least_square_fit<sample_type, evaluation_type> mag_calibrator_right[3],
       linear_least_square_fit<sample_type, evaluation_type> mag_calibrator_left[3],
       float scale_factor)
   {
     if( ( mag_calibrator_right[0].get_count() < MINIMUM_MAG_CALIBRATION_SAMPLES) )
-      return false;
+      return true;
     if( ( mag_calibrator_left[0].get_count() < MINIMUM_MAG_CALIBRATION_SAMPLES) )
-      return false;
-
-    // now we have enough entropy and evaluate our result
-    linear_least_square_result< float> new_calibration_data_right[3];
-    linear_least_square_result< float> new_calibration_data_left[3];
-    single_axis_calibration_t calibration_candidate[3];
+      return true;
 
+    // now we have enough entropy and evaluate our result, one axis per step
     for (unsigned i = 0; i < 3; ++i)
       {
-	mag_calibrator_right[i].evaluate( new_calibration_data_right[i]);
-	mag_calibrator_left[i].evaluate( new_calibration_data_left[i]);
-
-	calibration_candidate[i].refresh(
-	    (new_calibration_data_right[i].y_offset + new_calibration_data_left[i].y_offset) / scale_factor / TWO,
-	    (new_calibration_data_right[i].slope    + new_calibration_data_left[i].slope)    /  TWO,
-	    (new_calibration_data_right[i].variance_offset + new_calibration_data_left[i].variance_offset) / SQR(scale_factor) / TWO,
-	    (new_calibration_data_right[i].variance_slope  + new_calibration_data_left[i].variance_slope)  / TWO);
-
+	pending_right[i] = mag_calibrator_right[i];
+	pending_left[i]  = mag_calibrator_left[i];
 	mag_calibrator_right[i].reset();
 	mag_calibrator_left[i].reset();
       }
+    pending_scale_factor = scale_factor;
+    pending_step = 0;
+    evaluation_pending = true;
+    return false;
+  }
+
+  bool is_evaluation_pending( void) const
+  {
+    return evaluation_pending;
+  }
+
+  /**
+   * @brief evaluate one axis per call, the fourth call takes the result
+   *
+   * Keeps the cost per 10ms tick low.
+   * @return true if the calibration has been changed
+   */
+  bool evaluation_step( void)
+  {
+    if( ! evaluation_pending)
+      return false;
+
+    if( pending_step < 3)
+      {
+	unsigned i = pending_step++;
+	linear_least_square_result< float> new_calibration_data_right;
+	linear_least_square_result< float> new_calibration_data_left;
+
+	pending_right[i].evaluate( new_calibration_data_right);
+	pending_left[i].evaluate( new_calibration_data_left);
+
+	calibration_candidate[i].refresh(
+	    (new_calibration_data_right.y_offset + new_calibration_data_left.y_offset) / pending_scale_factor / TWO,
+	    (new_calibration_data_right.slope    + new_calibration_data_left.slope)    /  TWO,
+	    (new_calibration_data_right.variance_offset + new_calibration_data_left.variance_offset) / SQR(pending_scale_factor) / TWO,
+	    (new_calibration_data_right.variance_slope  + new_calibration_data_left.variance_slope)  / TWO);
+	return false;
+      }
+
+    evaluation_pending = false;
 
     if( ! parameters_changed_significantly ( calibration_candidate))
 	return false; // we keep the old calibration
@@ -145,6 +184,21 @@ public:
     return true;
   }
 
+  //! evaluate all at once, @return true if the calibration has been changed
+  bool set_calibration_if_changed(
+      linear_least_square_fit<sample_type, evaluation_type> mag_calibrator_right[3],
+      linear_least_square_fit<sample_type, evaluation_type> mag_calibrator_left[3],
+      float scale_factor)
+  {
+    if( start_evaluation( mag_calibrator_right, mag_calibrator_left, scale_factor))
+      return false;
+
+    bool changed = false;
+    while( evaluation_pending)
+      changed = evaluation_step();
+    return changed;
+  }
+
   bool isCalibrationDone () const
   {
     return calibration_done;
@@ -171,21 +225,24 @@ public:
     return false;
   }
 
-  void write_into_EEPROM (void) const
+  //! @return true on error, the calibration has not been written then
+  bool write_into_EEPROM (void) const
   {
     if( calibration_done == false)
-      return;
+      return false;
 
     EEPROM_initialize();
 
+    EEPROM_transaction_t transaction; // all or nothing, even on power loss
     float variance = 0.0f;
     for( unsigned i=0; i<3; ++i)
       {
-        write_EEPROM_value( (EEPROM_PARAMETER_ID)(MAG_X_OFF   + 2*i), calibration[i].offset);
-        write_EEPROM_value( (EEPROM_PARAMETER_ID)(MAG_X_SCALE + 2*i), calibration[i].scale);
+        transaction.stage( (EEPROM_PARAMETER_ID)(MAG_X_OFF   + 2*i), calibration[i].offset);
+        transaction.stage( (EEPROM_PARAMETER_ID)(MAG_X_SCALE + 2*i), calibration[i].scale);
         variance += calibration[i].variance;
       }
-    write_EEPROM_value(MAG_STD_DEVIATION, SQRT( variance / 6.0f));
+    transaction.stage(MAG_STD_DEVIATION, SQRT( variance / 6.0f));
+    return transaction.commit();
   }
 
   bool read_from_EEPROM (void)
@@ -213,6 +270,14 @@ public:
 
   single_axis_calibration_t calibration[3];
   bool calibration_done;
+
+private:
+  linear_least_square_fit<sample_type, evaluation_type> pending_right[3]; //!< data under evaluation
+  linear_least_square_fit<sample_type, evaluation_type> pending_left[3];
+  single_axis_calibration_t calibration_candidate[3];
+  float pending_scale_factor;
+  unsigned pending_step;	//!< next axis to be evaluated
+  bool evaluation_pending;
 };
 
 #endif /* COMPASS_CALIBRATION_H_ */
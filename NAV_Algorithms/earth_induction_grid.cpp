@@ -0,0 +1,139 @@
+/***********************************************************************//**
+ * @file		earth_induction_grid.cpp
+ * @brief		worldwide magnetic declination and inclination, grid lookup
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "earth_induction_grid.h"
+
+#define GRID_SCALE ((float)EARTH_INDUCTION_GRID_LSB)
+#define FULL_CIRCLE ((int)(360.0 / EARTH_INDUCTION_GRID_LSB)) // in grid units
+
+void earth_induction_grid_t::find_cell( double latitude, double longitude, grid_cell_t &cell, float &north, float &east)
+{
+  // grid coordinates, longitude wrapped, latitude clamped
+  float lon = (float)longitude;
+  while( lon < -180.0f)
+    lon += 360.0f;
+  while( lon >= 180.0f)
+    lon -= 360.0f;
+  float lat = (float)latitude;
+  if( lat < -90.0f)
+    lat = -90.0f;
+  if( lat > 90.0f)
+    lat = 90.0f;
+
+  float row_position    = (lat +  90.0f) * (1.0f / EARTH_INDUCTION_GRID_STEP);
+  float column_position = (lon + 180.0f) * (1.0f / EARTH_INDUCTION_GRID_STEP);
+  cell.row    = (unsigned)row_position;
+  cell.column = (unsigned)column_position;
+  if( cell.row > EARTH_INDUCTION_GRID_ROWS - 2)
+    cell.row = EARTH_INDUCTION_GRID_ROWS - 2;
+  if( cell.column > EARTH_INDUCTION_GRID_COLUMNS - 2)
+    cell.column = EARTH_INDUCTION_GRID_COLUMNS - 2;
+  north = row_position - cell.row;
+  east  = column_position - cell.column;
+}
+
+void earth_induction_grid_t::load_cell( grid_cell_t &cell)
+{
+  unsigned row = cell.row;
+  unsigned column = cell.column;
+
+  // declination may jump by 360 degrees near the magnetic poles: unwrap
+  int d00 = declination[row][column];
+  int d01 = declination[row][column + 1];
+  int d10 = declination[row + 1][column];
+  int d11 = declination[row + 1][column + 1];
+  if( d01 - d00 > FULL_CIRCLE / 2) d01 -= FULL_CIRCLE;
+  if( d01 - d00 < -FULL_CIRCLE / 2) d01 += FULL_CIRCLE;
+  if( d10 - d00 > FULL_CIRCLE / 2) d10 -= FULL_CIRCLE;
+  if( d10 - d00 < -FULL_CIRCLE / 2) d10 += FULL_CIRCLE;
+  if( d11 - d00 > FULL_CIRCLE / 2) d11 -= FULL_CIRCLE;
+  if( d11 - d00 < -FULL_CIRCLE / 2) d11 += FULL_CIRCLE;
+
+  cell.declination_south      = d00;
+  cell.declination_south_east = d01 - d00;
+  cell.declination_north      = d10;
+  cell.declination_north_east = d11 - d10;
+
+  cell.inclination_south      = inclination[row][column];
+  cell.inclination_south_east = inclination[row][column + 1] - inclination[row][column];
+  cell.inclination_north      = inclination[row + 1][column];
+  cell.inclination_north_east = inclination[row + 1][column + 1] - inclination[row + 1][column];
+}
+
+void earth_induction_grid_t::interpolate( const grid_cell_t &cell, float north, float east, float &declination, float &inclination)
+{
+  float south_value = cell.declination_south + east * cell.declination_south_east;
+  float north_value = cell.declination_north + east * cell.declination_north_east;
+  float value = ( south_value + north * (north_value - south_value)) * GRID_SCALE;
+  if( value > 180.0f)
+    value -= 360.0f;
+  if( value <= -180.0f)
+    value += 360.0f;
+  declination = value;
+
+  south_value = cell.inclination_south + east * cell.inclination_south_east;
+  north_value = cell.inclination_north + east * cell.inclination_north_east;
+  inclination = ( south_value + north * (north_value - south_value)) * GRID_SCALE;
+}
+
+induction_values earth_induction_grid_t::get_induction_data_at( double latitude, double longitude) const
+{
+  induction_values retv;
+  grid_cell_t cell;
+  float north, east;
+
+  find_cell( latitude, longitude, cell, north, east);
+  load_cell( cell);
+  interpolate( cell, north, east, retv.declination, retv.inclination);
+
+  retv.valid = true;
+  return retv;
+}
+
+void earth_induction_grid_t::get_induction_data_at( const double * latitude, const double * longitude, unsigned count,
+						     float * declination, float * inclination) const
+{
+  if( count == 0)
+    return;
+
+  grid_cell_t cell;
+  grid_cell_t loaded;
+  float north, east;
+  find_cell( latitude[0], longitude[0], loaded, north, east);
+  load_cell( loaded);
+
+  for( unsigned i = 0; i < count; ++i)
+    {
+      find_cell( latitude[i], longitude[i], cell, north, east);
+      if( cell.row != loaded.row || cell.column != loaded.column)
+	{
+	  loaded.row = cell.row;
+	  loaded.column = cell.column;
+	  load_cell( loaded);
+	}
+      interpolate( loaded, north, east, declination[i], inclination[i]);
+    }
+}
+
+const earth_induction_grid_t earth_induction_grid; //!< one read-only singleton object of this type
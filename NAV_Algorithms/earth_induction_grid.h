@@ -0,0 +1,86 @@
+/***********************************************************************//**
+ * @file		earth_induction_grid.h
+ * @brief		worldwide magnetic declination and inclination, grid lookup
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef NAV_ALGORITHMS_EARTH_INDUCTION_GRID_H_
+#define NAV_ALGORITHMS_EARTH_INDUCTION_GRID_H_
+
+#include "embedded_memory.h"
+#include "embedded_math.h"
+#include "earth_induction_model.h"
+
+#define EARTH_INDUCTION_GRID_STEP	5	//!< grid spacing / degrees
+#define EARTH_INDUCTION_GRID_ROWS	(180 / EARTH_INDUCTION_GRID_STEP + 1) //!< latitude -90 .. +90
+#define EARTH_INDUCTION_GRID_COLUMNS	(360 / EARTH_INDUCTION_GRID_STEP + 1) //!< longitude -180 .. +180
+#define EARTH_INDUCTION_GRID_LSB	0.01	//!< grid value resolution / degrees
+
+/**
+ * @brief World Magnetic Model on a grid, bilinear interpolation
+ *
+ * Valid everywhere, float only and O(1), cheap enough for every GNSS fix.
+ * The grid data are generated from WMM.COF,
+ * see World_Magnetic_Model_design/wmm_grid_generator.cpp.
+ */
+class earth_induction_grid_t
+{
+public:
+  earth_induction_grid_t( void)
+  {};
+
+  //! pure function of the position, safe to be used concurrently
+  induction_values get_induction_data_at( double latitude, double longitude) const;
+
+  /**
+   * @brief batch lookup for many positions, structure of arrays
+   *
+   * Same results as the single position lookup.
+   * GNSS tracks stay within one grid cell for thousands of fixes,
+   * the corner values of the cell are loaded and unwrapped only when the cell changes.
+   */
+  void get_induction_data_at( const double * latitude, const double * longitude, unsigned count,
+			      float * declination, float * inclination) const;
+
+private:
+  //! one grid cell, prepared for the interpolation
+  typedef struct
+  {
+    unsigned row;
+    unsigned column;
+    float declination_south, declination_south_east; //!< value and eastward difference, unwrapped
+    float declination_north, declination_north_east;
+    float inclination_south, inclination_south_east;
+    float inclination_north, inclination_north_east;
+  } grid_cell_t;
+
+  //! row and column of the cell and the position within it
+  static void find_cell( double latitude, double longitude, grid_cell_t &cell, float &north, float &east);
+  static void load_cell( grid_cell_t &cell);
+  static void interpolate( const grid_cell_t &cell, float north, float east, float &declination, float &inclination);
+
+  static ROM int16_t declination[EARTH_INDUCTION_GRID_ROWS][EARTH_INDUCTION_GRID_COLUMNS]; //!< positive to the east
+  static ROM int16_t inclination[EARTH_INDUCTION_GRID_ROWS][EARTH_INDUCTION_GRID_COLUMNS]; //!< positive downwards
+};
+
+extern const earth_induction_grid_t earth_induction_grid; //!< one read-only singleton object of this type
+
+#endif /* NAV_ALGORITHMS_EARTH_INDUCTION_GRID_H_ */
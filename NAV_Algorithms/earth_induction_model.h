@@ -55,9 +55,10 @@ public:
   earth_induction_model_t( void)
   {};
 
-  induction_values get_induction_data_at( double longitude, double latitude);
+  //! pure function of the position, safe to be used concurrently
+  induction_values get_induction_data_at( double latitude, double longitude) const;
 };
 
-extern earth_induction_model_t earth_induction_model; //!< one singleton object of this type
+extern const earth_induction_model_t earth_induction_model; //!< one read-only singleton object of this type
 
 #endif /* NAV_ALGORITHMS_EARTH_INDUCTION_MODEL_H_ */
@@ -23,6 +23,7 @@
  **************************************************************************/
 
 #include <navigator.h>
+#include "stage_profiler.h"
 
 // to be called at 100 Hz
 void navigator_t::update_at_100Hz (
@@ -30,13 +31,15 @@ void navigator_t::update_at_100Hz (
     const float3vector &mag,
     const float3vector &gyro)
 {
+  PROFILE_START( PROFILE_AHRS);
   ahrs.update( gyro, acc, mag,
 	    GNSS_acceleration,
 	    GNSS_heading,
 	    GNSS_fix_type == (SAT_FIX | SAT_HEADING));
+  PROFILE_STOP( PROFILE_AHRS);
 
 #if DEVELOPMENT_ADDITIONS
-  ahrs_magnetic.update_compass(
+  ahrs_magnetic.update( // queued only, see process_background_tasks()
 	  gyro, acc, mag,
 	  GNSS_acceleration);
 #endif
@@ -45,8 +48,11 @@ void navigator_t::update_at_100Hz (
   heading_vector[EAST]  = ahrs.get_east  ();
   heading_vector[DOWN]  = ahrs.get_down  ();
 
+  PROFILE_START( PROFILE_WIND);
   wind_observer.process_at_100_Hz( GNSS_velocity - heading_vector * TAS);
+  PROFILE_STOP( PROFILE_WIND);
 
+  PROFILE_START( PROFILE_VARIO);
   flight_observer.update_at_100Hz (
       GNSS_velocity,
       ahrs.get_nav_acceleration (),
@@ -57,6 +63,7 @@ void navigator_t::update_at_100Hz (
       wind_observer.get_speed_compensator_wind(),
       (GNSS_fix_type != 0)
       );
+  PROFILE_STOP( PROFILE_VARIO);
 }
 
 void navigator_t::update_GNSS_data( const coordinates_t &coordinates)
@@ -84,6 +91,7 @@ void navigator_t::update_GNSS_data( const coordinates_t &coordinates)
 // to be called at 10 Hz
 bool navigator_t::update_at_10Hz ()
 {
+  PROFILE_START( PROFILE_SLOW_PATH);
   bool landing_detected=false;
   atmosphere.feed_QFF_density_metering(
 	air_pressure_resampler_100Hz_10Hz.get_output(),
@@ -103,6 +111,7 @@ bool navigator_t::update_at_10Hz ()
       ahrs.write_calibration_into_EEPROM();
       landing_detected = true;
     }
+  PROFILE_STOP( PROFILE_SLOW_PATH);
   return landing_detected;
 }
 
@@ -145,10 +154,12 @@ void navigator_t::report_data( output_data_t &d)
     d.gyro_correction		= ahrs.get_gyro_correction();
     d.nav_acceleration_gnss 	= ahrs.get_nav_acceleration();
 
-    d.euler_magnetic		= ahrs_magnetic.get_euler();
-    d.q_magnetic		= ahrs_magnetic.get_attitude();
-    d.nav_acceleration_mag 	= ahrs_magnetic.get_nav_acceleration();
-    d.nav_induction_mag 	= ahrs_magnetic.get_nav_induction();
+    ahrs_magnetic.drain_if_unattended();
+    const shadow_AHRS_output_t &shadow = ahrs_magnetic.get_output();
+    d.euler_magnetic		= shadow.euler;
+    d.q_magnetic		= shadow.q;
+    d.nav_acceleration_mag 	= shadow.nav_acceleration;
+    d.nav_induction_mag 	= shadow.nav_induction;
 
     d.HeadingDifferenceAhrsDgnss = ahrs.getHeadingDifferenceAhrsDgnss();
     d.satfix			= (float)(d.c.sat_fix_type);
@@ -160,7 +171,7 @@ void navigator_t::report_data( output_data_t &d)
     d.inst_wind_corrected_E	= wind_observer.get_corrected_wind()[EAST];
     for( unsigned i=0; i<4; ++i)
       d.speed_compensation[i]  	= flight_observer.get_speed_compensation(i);
-    d.cross_acc_correction 	= ahrs_magnetic.get_cross_acc_correction();
+    d.cross_acc_correction 	= shadow.cross_acc_correction;
     d.vario_wind_N		= wind_observer.get_speed_compensator_wind()[NORTH];
     d.vario_wind_E		= wind_observer.get_speed_compensator_wind()[EAST];
 #endif
@@ -31,11 +31,16 @@
 #include <variometer.h>
 #include "GNSS.h"
 #include "differentiator.h"
+#include "coning_integrator.h"
 #include "atmosphere.h"
 #include "data_structures.h"
 #include "accumulating_averager.h"
 #include "airborne_detector.h"
 #include "wind_observer.h"
+#include "stage_profiler.h"
+#if DEVELOPMENT_ADDITIONS
+#include "shadow_AHRS.h"
+#endif
 
 //! organizes horizontal navigation, wind observation and variometer
 class navigator_t
@@ -154,6 +159,17 @@ public:
    */
   void update_at_100Hz( const float3vector &acc, const float3vector &mag, const float3vector &gyro);
 
+  /**
+   * @brief update AHRS from IMU, gyro integrated at the native IMU rate
+   *
+   * to be called @ 100 Hz, gyro_increments must be given in airframe coordinates
+   */
+  void update_at_100Hz( const float3vector &acc, const float3vector &mag, const coning_integrator_t &gyro_increments)
+  {
+    ahrs.set_coning_correction( gyro_increments.get_coning_correction());
+    update_at_100Hz( acc, mag, gyro_increments.get_mean_rate());
+  }
+
   /**
      * @brief slow update flight observer data
      *
@@ -187,6 +203,40 @@ public:
 #endif
   }
 
+  /**
+   * @brief low-priority work, decoupled from the 100 Hz path
+   *
+   * to be called from a background task, or on the host before report_data().
+   * Call register_background_task() first, otherwise
+   * report_data() does this work itself.
+   */
+  void process_background_tasks( void)
+  {
+#if DEVELOPMENT_ADDITIONS
+    PROFILE_START( PROFILE_AHRS_MAGNETIC);
+    ahrs_magnetic.process_pending();
+    PROFILE_STOP( PROFILE_AHRS_MAGNETIC);
+#endif
+  }
+
+  //! process_background_tasks() will be called from now on
+  void register_background_task( void)
+  {
+#if DEVELOPMENT_ADDITIONS
+    ahrs_magnetic.register_worker();
+#endif
+  }
+
+  //! shadow AHRS updates lost because the background task did not keep up
+  unsigned get_background_overruns( void) const
+  {
+#if DEVELOPMENT_ADDITIONS
+    return ahrs_magnetic.get_overruns();
+#else
+    return 0;
+#endif
+  }
+
   float get_IAS( void) const
   {
     return IAS;
@@ -195,7 +245,7 @@ public:
 private:
   AHRS_type	ahrs;
 #if DEVELOPMENT_ADDITIONS
-  AHRS_type	ahrs_magnetic;
+  shadow_AHRS_t	ahrs_magnetic; //!< compass-only AHRS, runs in process_background_tasks()
 #endif
   atmosphere_t 		atmosphere;
   variometer_t 	flight_observer;
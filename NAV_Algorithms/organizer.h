@@ -28,7 +28,8 @@
 #include <variometer.h>
 #include "data_structures.h"
 #include "navigator.h"
-#include "earth_induction_model.h"
+#include "earth_induction_grid.h"
+#include "stage_profiler.h"
 
 //! set of algorithms and data to be used by Larus flight sensor
 class organizer_t
@@ -37,8 +38,7 @@ public:
   organizer_t( void)
     : pitot_offset(0.0f),
       pitot_span(0.0f),
-      QNH_offset(0.0f),
-      magnetic_induction_update_counter(0)
+      QNH_offset(0.0f)
   {
 
   }
@@ -59,10 +59,11 @@ public:
 
   }
 
+  //! worldwide grid lookup, cheap enough for every GNSS fix
   void update_magnetic_induction_data( double latitude, double longitude)
   {
     induction_values induction_data;
-    induction_data = earth_induction_model.get_induction_data_at( latitude, longitude);
+    induction_data = earth_induction_grid.get_induction_data_at( latitude, longitude);
     if( induction_data.valid)
       navigator.update_magnetic_induction_data( induction_data.declination, induction_data.inclination);
   }
@@ -87,8 +88,7 @@ public:
 
   void on_new_pressure_data( output_data_t & output_data)
   {
-    navigator.update_pressure(output_data.m.static_pressure - QNH_offset);
-    navigator.update_pitot ( (output_data.m.pitot_pressure - pitot_offset) * pitot_span);
+    update_pressure( output_data.m);
   }
 
   bool update_every_100ms( output_data_t & output_data)
@@ -96,14 +96,17 @@ public:
     bool landing_detected = navigator.update_at_10Hz ();
     navigator.feed_QFF_density_metering( output_data.m.static_pressure - QNH_offset, -output_data.c.position[DOWN]);
 
-    if( ++magnetic_induction_update_counter > 36000) // every hour
-      {
-	update_magnetic_induction_data( output_data.c.latitude, output_data.c.longitude);
-	magnetic_induction_update_counter=0;
-      }
+    if( output_data.c.sat_fix_type & SAT_FIX) // follow the position
+      update_magnetic_induction_data( output_data.c.latitude, output_data.c.longitude);
     return landing_detected;
   }
 
+  //! to be called on every gyro reading if the IMU runs faster than 100 Hz
+  void on_new_gyro_sample( const float3vector &gyro_sensor_frame, float sampling_time)
+  {
+    gyro_increments.add_sample( gyro_sensor_frame, sampling_time);
+  }
+
   void set_attitude ( float roll, float nick, float present_heading)
   {
     navigator.set_attitude ( roll, nick, present_heading);
@@ -115,23 +118,65 @@ public:
 
   void update_every_10ms( output_data_t & output_data)
   {
-    // rotate sensor coordinates into airframe coordinates
-#if USE_LOWCOST_IMU == 1
-    acc  = sensor_mapping * output_data.m.lowcost_acc;
-    mag  = sensor_mapping * output_data.m.lowcost_mag;
-    gyro = sensor_mapping * output_data.m.lowcost_gyro;
-#else
-    acc  = sensor_mapping * output_data.m.acc;
-    mag  = sensor_mapping * output_data.m.mag;
-    gyro = sensor_mapping * output_data.m.gyro;
-#endif
+    update_IMU( output_data.m, output_data);
+  }
 
-#if DEVELOPMENT_ADDITIONS
-    output_data.body_acc  = acc;
-    output_data.body_gyro = gyro;
-#endif
+  /**
+   * @brief process a burst of 10ms samples, e.g. from the IMU FIFO
+   *
+   * Same as on_new_pressure_data() + update_every_10ms() for every sample.
+   * GNSS data must be set before, the 10 Hz slow path stays with the caller,
+   * so a burst must not cross a 100ms boundary.
+   * output_data.m is left with the last sample, one report_data() per burst will do.
+   */
+  void update_block( const measurement_data_t * measurements, unsigned count, output_data_t & output_data)
+  {
+    if( count == 0)
+      return;
+    for( const measurement_data_t *m = measurements; m < measurements + count; ++m)
+      {
+	update_pressure( *m);
+	update_IMU( *m, output_data);
+      }
+    output_data.m = measurements[count - 1];
+  }
 
-    navigator.update_at_100Hz (acc, mag, gyro);
+  //! process a chunk of recorded observations, GNSS data taken from every record
+  void update_block( const observations_type * records, unsigned count, output_data_t & output_data)
+  {
+    if( count == 0)
+      return;
+    for( const observations_type *r = records; r < records + count; ++r)
+      {
+	update_pressure( r->m);
+	navigator.update_GNSS_data( r->c);
+	update_IMU( r->m, output_data);
+      }
+    output_data.m = records[count - 1].m;
+    output_data.c = records[count - 1].c;
+  }
+
+  /**
+   * @brief low-priority work, to be called from a background task or before report_data()
+   *
+   * Integrations calling this must call register_background_task() once before,
+   * without it report_data() runs the work synchronously.
+   */
+  void process_background_tasks( void)
+  {
+    navigator.process_background_tasks();
+  }
+
+  //! announce that process_background_tasks() is called regularly from now on
+  void register_background_task( void)
+  {
+    navigator.register_background_task();
+  }
+
+  //! work dropped because process_background_tasks() did not keep up
+  unsigned get_background_overruns( void) const
+  {
+    return navigator.get_background_overruns();
   }
 
   void report_data ( output_data_t &data)
@@ -150,15 +195,58 @@ public:
   }
 
 private:
+  void update_pressure( const measurement_data_t & m)
+  {
+    PROFILE_START( PROFILE_PRESSURE);
+    navigator.update_pressure(m.static_pressure - QNH_offset);
+    navigator.update_pitot ( (m.pitot_pressure - pitot_offset) * pitot_span);
+    PROFILE_STOP( PROFILE_PRESSURE);
+  }
+
+  void update_IMU( const measurement_data_t & m, output_data_t & output_data)
+  {
+    // rotate sensor coordinates into airframe coordinates
+#if USE_LOWCOST_IMU == 1
+    acc  = sensor_mapping * m.lowcost_acc;
+    mag  = sensor_mapping * m.lowcost_mag;
+    gyro = sensor_mapping * m.lowcost_gyro;
+#else
+    acc  = sensor_mapping * m.acc;
+    mag  = sensor_mapping * m.mag;
+    gyro = sensor_mapping * m.gyro;
+#endif
+
+    coning_integrator_t airframe_increments;
+    bool gyro_oversampled = gyro_increments.get_samples() > 0;
+    if( gyro_oversampled)
+      {
+	airframe_increments = gyro_increments.rotated( sensor_mapping);
+	gyro = airframe_increments.get_mean_rate();
+	gyro_increments.reset();
+      }
+
+#if DEVELOPMENT_ADDITIONS
+    output_data.body_acc  = acc;
+    output_data.body_gyro = gyro;
+#else
+    (void)output_data;
+#endif
+
+    if( gyro_oversampled)
+      navigator.update_at_100Hz (acc, mag, airframe_increments);
+    else
+      navigator.update_at_100Hz (acc, mag, gyro);
+  }
+
   navigator_t navigator;
   float3vector acc; //!< acceleration in airframe system
   float3vector mag; //!< normalized magnetic induction in airframe system
   float3vector gyro; //!< rotation-rates in airframe system
+  coning_integrator_t gyro_increments; //!< high-rate gyro data in sensor system
   float3matrix sensor_mapping; //!< sensor -> airframe rotation matrix
   float pitot_offset; //!< pitot pressure sensor offset
   float pitot_span;   //!< pitot pressure sensor span factor
   float QNH_offset;   //!< static pressure sensor offset
-  unsigned magnetic_induction_update_counter;
 };
 
 #endif /* ORGANIZER_H_ */
@@ -26,8 +26,9 @@
 #include "embedded_memory.h"
 #include "embedded_math.h"
 #include "persistent_data.h"
+#include "EEPROM_transaction.h"
 
-ROM persistent_data_t PERSISTENT_DATA[]=
+constexpr ROM persistent_data_t PERSISTENT_DATA[]=
     {
 	{SENS_TILT_ROLL,"SensTilt_Roll",	true,  0.0f, 0}, 	//! IMU Sensor tilt angle signed / degrees front right down frame
 	{SENS_TILT_PITCH,"SensTilt_Pitch",	true,  0.0f, 0}, 	//! IMU Sensor tilt angle signed
@@ -58,12 +59,136 @@ ROM persistent_data_t PERSISTENT_DATA[]=
 	{ANT_SLAVE_RIGHT,"ANT_SLAVE_RIGHT",	false, 0.0f, 0},	//! Slave DGNSS antenna more right /mm
     };
 
-ROM unsigned PERSISTENT_DATA_ENTRIES = sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t);
+constexpr ROM unsigned PERSISTENT_DATA_ENTRIES = sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t);
+
+// compile-time lookup tables: parameter ID -> entry and perfect hash mnemonic -> entry
+
+#define NO_ENTRY 0xff
+#define NAME_HASH_SIZE 64
+
+static_assert( sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t) < NO_ENTRY, "too many parameters");
+
+//! FNV-1a step, the mnemonic hash is built char by char
+static constexpr uint32_t name_hash_step( uint32_t hash, char c)
+{
+  return (hash ^ (uint8_t)c) * 16777619u;
+}
+
+static constexpr unsigned name_hash_slot( uint32_t hash)
+{
+  return (hash ^ (hash >> 16)) & (NAME_HASH_SIZE - 1);
+}
+
+static constexpr unsigned mnemonic_length( const char * mnemonic)
+{
+  unsigned length = 0;
+  while( length < persistent_data_t::MNEMONIC_LENGTH && mnemonic[length])
+    ++length;
+  return length;
+}
+
+typedef struct
+{
+  uint8_t by_ID[EEPROM_PARAMETER_ID_END];	//!< index into PERSISTENT_DATA
+  uint8_t by_name[NAME_HASH_SIZE];		//!< index into PERSISTENT_DATA
+  uint8_t name_length[NAME_HASH_SIZE];		//!< mnemonic length of this slot
+  uint32_t lengths;				//!< bit n set: some mnemonic has n characters
+  uint32_t seed;				//!< hash seed giving no collisions
+  bool perfect;					//!< seed found
+  bool prefix_free;				//!< no mnemonic is the prefix of another one
+} parameter_lookup_t;
+
+static constexpr parameter_lookup_t make_parameter_lookup( void)
+{
+  parameter_lookup_t t = { };
+  const unsigned entries = sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t);
+
+  for( unsigned i = 0; i < EEPROM_PARAMETER_ID_END; ++i)
+    t.by_ID[i] = NO_ENTRY;
+  for( unsigned i = entries; i > 0; --i) // the first entry wins, like a linear search
+    t.by_ID[PERSISTENT_DATA[i-1].id] = i-1;
+
+  t.prefix_free = true;
+  for( unsigned i = 0; i < entries; ++i)
+    {
+      unsigned length = mnemonic_length( PERSISTENT_DATA[i].mnemonic);
+      t.lengths |= 1u << length;
+      for( unsigned k = 0; k < entries; ++k)
+	{
+	  if( k == i || mnemonic_length( PERSISTENT_DATA[k].mnemonic) < length)
+	    continue;
+	  unsigned n = 0;
+	  while( n < length && PERSISTENT_DATA[i].mnemonic[n] == PERSISTENT_DATA[k].mnemonic[n])
+	    ++n;
+	  if( n == length)
+	    t.prefix_free = false;
+	}
+    }
+
+  for( uint32_t seed = 2166136261u; seed < 2166136261u + 10000u; ++seed)
+    {
+      for( unsigned slot = 0; slot < NAME_HASH_SIZE; ++slot)
+	t.by_name[slot] = NO_ENTRY;
+
+      bool collision = false;
+      for( unsigned i = 0; i < entries && ! collision; ++i)
+	{
+	  uint32_t hash = seed;
+	  unsigned length = mnemonic_length( PERSISTENT_DATA[i].mnemonic);
+	  for( unsigned n = 0; n < length; ++n)
+	    hash = name_hash_step( hash, PERSISTENT_DATA[i].mnemonic[n]);
+	  unsigned slot = name_hash_slot( hash);
+	  if( t.by_name[slot] != NO_ENTRY)
+	    collision = true;
+	  t.by_name[slot] = i;
+	  t.name_length[slot] = length;
+	}
+
+      if( ! collision)
+	{
+	  t.seed = seed;
+	  t.perfect = true;
+	  break;
+	}
+    }
+  return t;
+}
+
+static constexpr ROM parameter_lookup_t PARAMETER_LOOKUP = make_parameter_lookup();
+
+static_assert( PARAMETER_LOOKUP.perfect, "no perfect hash found, increase NAME_HASH_SIZE");
+static_assert( PARAMETER_LOOKUP.prefix_free, "a mnemonic must not be the prefix of another one");
+
+#define VIRTUAL_ADDRESS_COUNT (2 * sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t) + 1)
+
+typedef struct
+{
+  uint16_t address[VIRTUAL_ADDRESS_COUNT];
+} virtual_address_table_t;
+
+static constexpr virtual_address_table_t make_virtual_address_table( void)
+{
+  virtual_address_table_t t = { };
+  const unsigned entries = sizeof(PERSISTENT_DATA) / sizeof(persistent_data_t);
+  for( unsigned i = 0; i < entries; ++i)
+    {
+      t.address[2*i]   = (uint16_t)EEPROM_slot_address( PERSISTENT_DATA[i].id, false);
+      t.address[2*i+1] = (uint16_t)EEPROM_slot_address( PERSISTENT_DATA[i].id, true);
+    }
+  t.address[VIRTUAL_ADDRESS_COUNT - 1] = EEPROM_SELECTOR;
+  return t;
+}
+
+static constexpr ROM virtual_address_table_t VIRTUAL_ADDRESS_TABLE = make_virtual_address_table();
+
+const uint16_t * const EEPROM_VIRTUAL_ADDRESSES = VIRTUAL_ADDRESS_TABLE.address;
+const unsigned EEPROM_VIRTUAL_ADDRESS_COUNT = VIRTUAL_ADDRESS_COUNT;
 
 void ensure_EEPROM_parameter_integrity( void)
 {
   bool EEPROM_has_been_unlocked = false;
   float dummy;
+  EEPROM_transaction_t transaction;
   const persistent_data_t * parameter = PERSISTENT_DATA;
   while( parameter < PERSISTENT_DATA + PERSISTENT_DATA_ENTRIES)
     {
@@ -74,28 +199,52 @@ void ensure_EEPROM_parameter_integrity( void)
 	      lock_EEPROM( false);
 	      EEPROM_has_been_unlocked = true;
 	    }
-	  (void) write_EEPROM_value( parameter->id, parameter->default_value);
+	  if( transaction.stage( parameter->id, parameter->default_value)) // transaction full
+	    {
+	      (void) transaction.commit();
+	      (void) transaction.stage( parameter->id, parameter->default_value);
+	    }
 	}
       ++parameter;
     }
   if( EEPROM_has_been_unlocked)
-    lock_EEPROM( true);
+    {
+      (void) transaction.commit();
+      lock_EEPROM( true);
+    }
 }
 
+/**
+ * @brief find the parameter whose mnemonic starts the given text
+ *
+ * The text may continue behind the mnemonic, e.g. with a value.
+ * Hashing runs along the text, probing at all existing mnemonic lengths.
+ */
 const persistent_data_t * find_parameter_from_name( char * name)
 {
-  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < (PERSISTENT_DATA+PERSISTENT_DATA_ENTRIES); ++parameter )
-    if( 0 == strncmp( parameter->mnemonic, name, strlen( parameter->mnemonic)))
-      return parameter;
+  uint32_t hash = PARAMETER_LOOKUP.seed;
+  for( unsigned length = 1; length <= persistent_data_t::MNEMONIC_LENGTH && name[length-1]; ++length)
+    {
+      hash = name_hash_step( hash, name[length-1]);
+      if( ( PARAMETER_LOOKUP.lengths & (1u << length)) == 0)
+	continue;
+
+      unsigned slot = name_hash_slot( hash);
+      unsigned index = PARAMETER_LOOKUP.by_name[slot];
+      if( ( index != NO_ENTRY)
+	  && ( PARAMETER_LOOKUP.name_length[slot] == length)
+	  && ( 0 == strncmp( PERSISTENT_DATA[index].mnemonic, name, length)))
+	return PERSISTENT_DATA + index;
+    }
   return 0;
 }
 
 const persistent_data_t * find_parameter_from_ID( EEPROM_PARAMETER_ID id)
 {
-  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < (PERSISTENT_DATA+PERSISTENT_DATA_ENTRIES); ++parameter )
-    if( parameter->id == id)
-      return parameter;
-  return 0;
+  if( (unsigned)id >= EEPROM_PARAMETER_ID_END)
+    return 0;
+  unsigned index = PARAMETER_LOOKUP.by_ID[id];
+  return index == NO_ENTRY ? 0 : PERSISTENT_DATA + index;
 }
 
 #if UNIX != 1
@@ -214,33 +363,98 @@ bool lock_EEPROM( bool lockit)
   return (EE_Init());
 }
 
-bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value)
+static float configuration_cache[EEPROM_PARAMETER_ID_END]; //!< RAM copy of the EEPROM parameters
+static bool configuration_cached[EEPROM_PARAMETER_ID_END];
+static uint16_t selector_cache; //!< RAM copy of the slot selector, changed by write_EEPROM_selector() only
+static bool selector_cached;
+
+void load_configuration_cache( void)
+{
+  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < (PERSISTENT_DATA+PERSISTENT_DATA_ENTRIES); ++parameter )
+    configuration_cached[parameter->id] = ! read_EEPROM_value( parameter->id, configuration_cache[parameter->id]);
+}
+
+bool write_EEPROM_slot( EEPROM_PARAMETER_ID id, float value, bool slot_B)
 {
   EEPROM_data_t EEPROM_value;
   if( EEPROM_convert( id, EEPROM_value, value , WRITE))
       return true; // error
+  configuration_cached[id] = false; // will be read again with EEPROM resolution
 
+  unsigned address = EEPROM_slot_address( id, slot_B);
   EEPROM_data_t read_value;
-  if( (HAL_OK != EE_ReadVariable( id, &read_value.u16))
+  if( (HAL_OK != EE_ReadVariable( address, &read_value.u16))
       ||
       (read_value.u16 != EEPROM_value.u16) )
-	return EE_WriteVariable( id, EEPROM_value.u16);
+	return EE_WriteVariable( address, EEPROM_value.u16);
   return HAL_OK;
 }
 
-bool read_EEPROM_value( EEPROM_PARAMETER_ID id, float &value)
+static bool read_EEPROM_slot( EEPROM_PARAMETER_ID id, float &value, bool slot_B)
 {
   uint16_t data;
-  if( HAL_OK != EE_ReadVariable( id, (uint16_t*)&data))
+  if( HAL_OK != EE_ReadVariable( EEPROM_slot_address( id, slot_B), (uint16_t*)&data))
     return true;
   return ( EEPROM_convert( id, (EEPROM_data_t &)data, value , READ));
 }
 
+bool copy_EEPROM_slot( EEPROM_PARAMETER_ID id, bool to_slot_B, float value_if_missing)
+{
+  uint16_t data, read_value;
+  if( HAL_OK != EE_ReadVariable( EEPROM_slot_address( id, ! to_slot_B), &data))
+    return write_EEPROM_slot( id, value_if_missing, to_slot_B);
+
+  unsigned address = EEPROM_slot_address( id, to_slot_B);
+  if( (HAL_OK != EE_ReadVariable( address, &read_value)) || (read_value != data))
+    return EE_WriteVariable( address, data);
+  return HAL_OK;
+}
+
+bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value)
+{
+  return write_EEPROM_slot( id, value, EEPROM_uses_slot_B( read_EEPROM_selector(), id));
+}
+
+bool read_EEPROM_value( EEPROM_PARAMETER_ID id, float &value)
+{
+  return read_EEPROM_slot( id, value, EEPROM_uses_slot_B( read_EEPROM_selector(), id));
+}
+
+bool write_EEPROM_selector( uint16_t selector)
+{
+  for( unsigned i = 0; i < EEPROM_PARAMETER_ID_END; ++i)
+    configuration_cached[i] = false; // the other slot may be taken now
+
+  selector_cached = false; // read back on the next access, whatever happens
+
+  uint16_t read_value;
+  if( (HAL_OK != EE_ReadVariable( EEPROM_SELECTOR, &read_value)) || (read_value != selector))
+    return EE_WriteVariable( EEPROM_SELECTOR, selector);
+  return HAL_OK;
+}
+
+uint16_t read_EEPROM_selector( void)
+{
+  if( selector_cached)
+    return selector_cache;
+
+  if( HAL_OK != EE_ReadVariable( EEPROM_SELECTOR, &selector_cache))
+    selector_cache = 0; // never written: all parameters in slot A
+  selector_cached = true;
+  return selector_cache;
+}
+
 float configuration( EEPROM_PARAMETER_ID id)
 {
+  ASSERT( id < EEPROM_PARAMETER_ID_END);
+  if( configuration_cached[id])
+    return configuration_cache[id];
+
   float value;
   bool result = read_EEPROM_value( id, value);
   ASSERT( result == false);
+  configuration_cache[id] = value;
+  configuration_cached[id] = true;
   return value;
 }
 
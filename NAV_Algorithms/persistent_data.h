@@ -92,17 +92,52 @@ public:
 const persistent_data_t * find_parameter_from_name( char * name);
 const persistent_data_t * find_parameter_from_ID( EEPROM_PARAMETER_ID id);
 
+/**
+ * @brief A/B parameter slots for EEPROM transactions, see EEPROM_transaction.h
+ *
+ * Slot A of a parameter is its ID, slot B lives at EEPROM_SLOT_B_BASE + ID.
+ * Bit n of the selector word chooses the slot of the parameter group n,
+ * a group being one decade of parameter IDs.
+ * A missing selector reads as zero: all parameters in slot A, as before.
+ */
+#define EEPROM_SLOT_B_BASE	0x100
+#define EEPROM_SELECTOR		(EEPROM_SLOT_B_BASE + EEPROM_PARAMETER_ID_END)
+#define EEPROM_GROUP_SIZE	10
+#define EEPROM_TRANSACTION_ENTRIES	8 //!< parameters per transaction
+
+static_assert( ( EEPROM_PARAMETER_ID_END - 1) / EEPROM_GROUP_SIZE < 16, "one selector bit per parameter group");
+
+constexpr bool EEPROM_uses_slot_B( uint16_t selector, EEPROM_PARAMETER_ID id)
+{
+  return ( selector >> ( id / EEPROM_GROUP_SIZE)) & 1;
+}
+
+constexpr unsigned EEPROM_slot_address( EEPROM_PARAMETER_ID id, bool slot_B)
+{
+  return slot_B ? EEPROM_SLOT_B_BASE + id : id;
+}
+
 // standard function to read configuration data from EEPROM
 float configuration( EEPROM_PARAMETER_ID id);
-bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value);
+bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value); //!< into the selected slot
 bool read_EEPROM_value( EEPROM_PARAMETER_ID id, float &value);
+bool write_EEPROM_slot( EEPROM_PARAMETER_ID id, float value, bool slot_B); //!< true on error
+bool copy_EEPROM_slot( EEPROM_PARAMETER_ID id, bool to_slot_B, float value_if_missing); //!< bit-exact, true on error
+bool write_EEPROM_selector( uint16_t selector); //!< true on error
+uint16_t read_EEPROM_selector( void); //!< zero if never written
 bool lock_EEPROM( bool lockit);
 bool EEPROM_initialize( void);
 void ensure_EEPROM_parameter_integrity(void);
+void load_configuration_cache( void); //!< read all parameters into RAM, once at boot
 
 extern const persistent_data_t PERSISTENT_DATA[];
 extern const unsigned PERSISTENT_DATA_ENTRIES;
 
+//! virtual EEPROM addresses: both slots of every PERSISTENT_DATA parameter and the selector
+//! to be used as VirtAddVarTab of the ST EEPROM emulation
+extern const uint16_t * const EEPROM_VIRTUAL_ADDRESSES;
+extern const unsigned EEPROM_VIRTUAL_ADDRESS_COUNT;
+
 #endif ///#ifdef __cplusplus
 
 #endif /* INC_PERSISTENT_DATA_H_ */
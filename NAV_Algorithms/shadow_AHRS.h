@@ -0,0 +1,250 @@
+/***********************************************************************//**
+ * @file		shadow_AHRS.h
+ * @brief		magnetic-only AHRS running outside the 100 Hz path for diagnostics
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef SHADOW_AHRS_H_
+#define SHADOW_AHRS_H_
+
+#include "AHRS.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+
+#define SHADOW_AHRS_QUEUE_SIZE 32 //!< 320ms backlog for the low-priority worker
+
+//! one command from the 100 Hz path to the shadow AHRS
+typedef struct
+{
+  enum { UPDATE, SET_ATTITUDE, INDUCTION_DATA } type;
+  float3vector gyro;		//!< UPDATE: IMU data, SET_ATTITUDE: roll nick yaw
+  float3vector acc;		//!< INDUCTION_DATA: declination inclination
+  float3vector mag;
+  float3vector GNSS_acceleration;
+} shadow_AHRS_command_t;
+
+//! state command that did not fit into the queue, see shadow_AHRS_t::send()
+typedef struct
+{
+  shadow_AHRS_command_t command;
+  unsigned position;	//!< queue position it belongs to: commands sent before
+  unsigned sequence;	//!< incremented for every latched command, 0: none yet
+} shadow_AHRS_latch_t;
+
+//! results of the shadow AHRS, the diagnostic fields of output_data_t
+typedef struct
+{
+  eulerangle<float> euler;
+  quaternion<float> q;
+  float3vector nav_acceleration;
+  float3vector nav_induction;
+  float cross_acc_correction;
+} shadow_AHRS_output_t;
+
+/**
+ * @brief compass-only AHRS for comparison with the primary AHRS
+ *
+ * The 100 Hz path only queues its input data.
+ * The AHRS itself runs in process_pending(), to be called by a
+ * low-priority task or thread, results are published wait-free.
+ * On the host call process_pending() from the replay thread
+ * to get deterministic results.
+ * Without a registered worker the reader drains the queue itself,
+ * see drain_if_unattended().
+ * If the worker does not keep up, UPDATE commands are dropped,
+ * SET_ATTITUDE and INDUCTION_DATA are latched and never lost.
+ */
+class shadow_AHRS_t
+{
+public:
+  shadow_AHRS_t( float sampling_time)
+  : ahrs( sampling_time),
+    sent( 0),
+    received( 0),
+    overruns( 0),
+    worker_registered( false)
+  {
+    for( unsigned i = 0; i < LATCHES; ++i)
+      latch_sequence[i] = applied_sequence[i] = 0;
+    publish();
+  }
+
+  //! producer side, 100 Hz
+  void update( const float3vector &gyro, const float3vector &acc, const float3vector &mag,
+	       const float3vector &GNSS_acceleration)
+  {
+    shadow_AHRS_command_t command;
+    command.type = shadow_AHRS_command_t::UPDATE;
+    command.gyro = gyro;
+    command.acc = acc;
+    command.mag = mag;
+    command.GNSS_acceleration = GNSS_acceleration;
+    send( command);
+  }
+
+  void set_from_euler( float roll, float nick, float yaw)
+  {
+    shadow_AHRS_command_t command;
+    command.type = shadow_AHRS_command_t::SET_ATTITUDE;
+    command.gyro[0] = roll;
+    command.gyro[1] = nick;
+    command.gyro[2] = yaw;
+    send( command);
+  }
+
+  void update_magnetic_induction_data( float declination, float inclination)
+  {
+    shadow_AHRS_command_t command;
+    command.type = shadow_AHRS_command_t::INDUCTION_DATA;
+    command.acc[0] = declination;
+    command.acc[1] = inclination;
+    send( command);
+  }
+
+  //! consumer side: execute all queued commands and publish the result
+  void process_pending( void)
+  {
+    shadow_AHRS_command_t command;
+    bool updated = false;
+
+    for( ;;)
+      {
+	updated |= execute_latched();
+	if( queue.pop( command))
+	  break;
+	++received;
+	execute( command);
+	updated = true;
+      }
+
+    if( updated)
+      publish();
+  }
+
+  //! announce a consumer calling process_pending(), before it starts
+  void register_worker( void)
+  {
+    worker_registered = true;
+  }
+
+  //! reader side: run the AHRS here if nobody else will
+  void drain_if_unattended( void)
+  {
+    if( ! worker_registered)
+      process_pending();
+  }
+
+  //! reader side: most recent results
+  const shadow_AHRS_output_t & get_output( void)
+  {
+    return output.read();
+  }
+
+  //! number of UPDATE commands lost because the worker did not keep up
+  unsigned get_overruns( void) const
+  {
+    return overruns;
+  }
+
+private:
+  enum { LATCHES = 2 }; //!< SET_ATTITUDE and INDUCTION_DATA
+
+  //! producer side: queue the command, if full drop a stale update or latch a state command
+  void send( const shadow_AHRS_command_t & command)
+  {
+    if( ! queue.push( command))
+      {
+	++sent;
+	return;
+      }
+
+    if( command.type == shadow_AHRS_command_t::UPDATE)
+      {
+	++overruns;
+	return;
+      }
+
+    // newest state wins, it replaces a latched command of the same type not yet executed
+    unsigned i = command.type - shadow_AHRS_command_t::SET_ATTITUDE;
+    shadow_AHRS_latch_t & l = latched[i].get_write_buffer();
+    l.command = command;
+    l.position = sent;
+    l.sequence = ++latch_sequence[i];
+    latched[i].publish();
+  }
+
+  //! consumer side: execute latched commands due before the next queued one
+  bool execute_latched( void)
+  {
+    bool executed = false;
+    for( unsigned i = 0; i < LATCHES; ++i)
+      {
+	const shadow_AHRS_latch_t & l = latched[i].read();
+	if( l.sequence != applied_sequence[i] && (int)( l.position - received) <= 0)
+	  {
+	    execute( l.command);
+	    applied_sequence[i] = l.sequence;
+	    executed = true;
+	  }
+      }
+    return executed;
+  }
+
+  void execute( const shadow_AHRS_command_t & command)
+  {
+    switch( command.type)
+      {
+      case shadow_AHRS_command_t::UPDATE:
+	ahrs.update_compass( command.gyro, command.acc, command.mag, command.GNSS_acceleration);
+	break;
+      case shadow_AHRS_command_t::SET_ATTITUDE:
+	ahrs.set_from_euler( command.gyro[0], command.gyro[1], command.gyro[2]);
+	break;
+      case shadow_AHRS_command_t::INDUCTION_DATA:
+	ahrs.update_magnetic_induction_data( command.acc[0], command.acc[1]);
+	break;
+      }
+  }
+
+  void publish( void)
+  {
+    shadow_AHRS_output_t & o = output.get_write_buffer();
+    o.euler 		= ahrs.get_euler();
+    o.q 		= ahrs.get_attitude();
+    o.nav_acceleration 	= ahrs.get_nav_acceleration();
+    o.nav_induction 	= ahrs.get_nav_induction();
+    o.cross_acc_correction = ahrs.get_cross_acc_correction();
+    output.publish();
+  }
+
+  AHRS_type ahrs; //!< owned by the consumer
+  spsc_queue< shadow_AHRS_command_t, SHADOW_AHRS_QUEUE_SIZE> queue;
+  triple_buffer< shadow_AHRS_output_t> output;
+  triple_buffer< shadow_AHRS_latch_t> latched[LATCHES];
+  unsigned sent;			//!< commands queued, owned by the producer
+  unsigned latch_sequence[LATCHES];	//!< owned by the producer
+  unsigned received;			//!< commands popped, owned by the consumer
+  unsigned applied_sequence[LATCHES];	//!< owned by the consumer
+  unsigned overruns;
+  bool worker_registered; //!< process_pending() is called by a background task
+};
+
+#endif /* SHADOW_AHRS_H_ */
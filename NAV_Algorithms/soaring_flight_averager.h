@@ -33,8 +33,16 @@
 #define ONE_DIV_2PI 0.159155f
 #define PI_TIMES_2 6.2832f
 
-//! template for an average filter for circling and straight flight
-template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOFF = true>
+/**
+ * @brief template for an average filter for circling and straight flight
+ *
+ * While circling the output is the mean of the sector averages of the last circle.
+ * The sum of the averages of all other sectors changes only on a sector change
+ * and is maintained together with the number of used sectors,
+ * so an update is O(1) independent of N_SECTORS.
+ * Once per circle the sum is recomputed to remove accumulated rounding errors.
+ */
+template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOFF = true, unsigned N_SECTORS = 16>
   class soaring_flight_averager
   {
   public:
@@ -42,11 +50,15 @@ template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOF
 	active_state (STRAIGHT_FLIGHT),
 	averager (normalized_stop_frequency),
 	present_output(0),
+	sum_of_other_sectors(0),
+	present_sector_average(0),
+	used_sectors(0),
+	sector_changes(0),
 	old_sector(0)
     {
       for (unsigned index = 0; index < N_SECTORS; ++index)
 	  {
-	    sector_averages[index] = {0};
+	    sector_sums[index] = {0};
 	    sector_sample_count[index] = 0;
 	  }
     };
@@ -115,17 +127,37 @@ template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOF
 
       if( old_sector != index) // on sector change
 	{
+	  if( sector_sample_count[old_sector] > 0) // the old sector is complete now
+	    sum_of_other_sectors = sum_of_other_sectors + present_sector_average;
 	  old_sector = index;
+
+	  if( sector_sample_count[index] > 0) // becomes the present sector
+	    sum_of_other_sectors = sum_of_other_sectors - get_sector_average( index);
+
 	  if( sector_sample_count[index] > 1) // if sector has been used in the circle before
 	    {
 	      // reset sector
 	      sector_sample_count[index] = 0;
-	      sector_averages[index] = {0};
+	      sector_sums[index] = {0};
+	      --used_sectors;
+	    }
+
+	  if( ++sector_changes >= N_SECTORS) // once per circle: remove accumulated rounding errors
+	    {
+	      sector_changes = 0;
+	      sum_of_other_sectors = {0};
+	      for (unsigned i = 0; i < N_SECTORS; ++i)
+		if( i != index && sector_sample_count[i] > 0)
+		  sum_of_other_sectors = sum_of_other_sectors + get_sector_average( i);
 	    }
 	}
 
-      sector_averages[index] += current_value;
+      if( sector_sample_count[index] == 0)
+	++used_sectors;
+
+      sector_sums[index] += current_value;
       ++ sector_sample_count[index];
+      present_sector_average = get_sector_average( index);
     }
 
     void reset( value_t value)
@@ -133,18 +165,18 @@ template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOF
       averager.settle(value);
       for (unsigned i = 0; i < N_SECTORS; ++i)
 	{
-	  sector_averages[i] = {0};
+	  sector_sums[i] = {0};
 	  sector_sample_count[i] = 0;
 	}
+      sum_of_other_sectors = {0};
+      present_sector_average = {0};
+      used_sectors = 0;
       present_output = value;
     }
 
     bool circle_completed (void) const
     {
-      for (unsigned index = 0; index < N_SECTORS; ++index)
-	if( sector_sample_count[index] == 0)
-	  return false;
-      return true;
+      return used_sectors == N_SECTORS;
     }
 
     void relax( void)
@@ -154,21 +186,17 @@ template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOF
 
   private:
 
-    value_t get_boxcar_average( void)
+    value_t get_boxcar_average( void) const
     {
-      value_t average = { 0 };
-
-      unsigned number_of_used_sectors = 0;
-      for (unsigned index = 0; index < N_SECTORS; ++index)
-	if( sector_sample_count[index] > 0)
-	  {
-	    average = average + sector_averages[index] * ( ONE / sector_sample_count[index]);
-	    ++number_of_used_sectors;
-	  }
-      if( number_of_used_sectors == 0)
+      if( used_sectors == 0)
 	return {0};
       else
-	return average * (1.0f / (float) number_of_used_sectors); // as division may not be implemented
+	return ( sum_of_other_sectors + present_sector_average) * (1.0f / (float) used_sectors); // as division may not be implemented
+    }
+
+    value_t get_sector_average( unsigned index) const
+    {
+      return sector_sums[index] * ( ONE / sector_sample_count[index]);
     }
 
     unsigned find_sector_index( float heading)
@@ -181,20 +209,27 @@ template<class value_t, bool CLAMP_OUTPUT_FIRST_CIRCLE = false, bool SOFT_TAKEOF
 
     void fill_recordings_with_value ( value_t value)
     {
+      sum_of_other_sectors = {0};
       for (unsigned i = 0; i < N_SECTORS; ++i)
 	{
-	  sector_averages[i] = value;
+	  sector_sums[i] = value;
 	  sector_sample_count[i] = 1;
+	  if( i != old_sector)
+	    sum_of_other_sectors = sum_of_other_sectors + value;
 	}
+      present_sector_average = value;
+      used_sectors = N_SECTORS;
     }
 
-    enum { N_SECTORS = 16};
-
     circle_state_t active_state;
     pt2<value_t, float> averager; // IIR-averager for straight flight
     value_t present_output; // maintained to save computing time
-    value_t sector_averages[N_SECTORS]; // boxcar averager for circling flight
+    value_t sector_sums[N_SECTORS]; // boxcar averager for circling flight
     unsigned sector_sample_count[N_SECTORS]; // boxcar averager for circling flight
+    value_t sum_of_other_sectors; // sum of the averages of the used sectors except old_sector
+    value_t present_sector_average; // average of sector old_sector
+    unsigned used_sectors; // number of sectors with samples
+    unsigned sector_changes; // counter for the recomputation of sum_of_other_sectors
     unsigned old_sector;
   };
 
@@ -30,6 +30,7 @@
 #define RECIP_GRAVITY 0.1094f
 
 //! calculate instant windspeed and variometer data, update @ 100 Hz
+template< class speed_compensation>
 void variometer_t::update_at_100Hz (
     const float3vector &gnss_velocity,
     const float3vector &ahrs_acceleration,
@@ -41,8 +42,19 @@ void variometer_t::update_at_100Hz (
     bool GNSS_fix_avaliable
   )
 {
-  vario_uncompensated_pressure = KalmanVario_pressure.update (
-      pressure_altitude, ahrs_acceleration[DOWN]);
+  // all four Kalman filters in one pass, the GNSS-based ones only with a fix
+  // horizontal observers for velocity and acceleration in the air- (not ground) system
+  float air_velocity_north = gnss_velocity[NORTH] - speed_compensator_wind[NORTH];
+  float air_velocity_east  = gnss_velocity[EAST]  - speed_compensator_wind[EAST];
+  const float y[variometer_kalman_bank_t::L][variometer_kalman_bank_t::LANES] =
+    { // PRESSURE_LANE	  GNSS_LANE		  NORTH_LANE		    EAST_LANE
+	{ pressure_altitude,	  GNSS_negative_altitude, air_velocity_north,	    air_velocity_east },
+	{ ahrs_acceleration[DOWN], gnss_velocity[DOWN],	  ahrs_acceleration[NORTH], ahrs_acceleration[EAST] },
+	{ 0.0f,			  ahrs_acceleration[DOWN], 0.0f,		    0.0f }
+    };
+  kalman_bank.update( y, GNSS_fix_avaliable ? (unsigned)variometer_kalman_bank_t::ALL_LANES : 1 << PRESSURE_LANE);
+
+  vario_uncompensated_pressure = KalmanVario_pressure.get_x( KalmanVario_t::VARIO);
   speed_compensation_IAS = kinetic_energy_differentiator.respond (
       IAS * IAS * ONE_DIV_BY_GRAVITY_TIMES_2);
   vario_averager_pressure.respond (
@@ -59,16 +71,7 @@ void variometer_t::update_at_100Hz (
   else
     {
       // The Kalman-filter-based un-compensated variometer in NED-system reports negative if *climbing* !
-      vario_uncompensated_GNSS = -KalmanVario_GNSS.update ( GNSS_negative_altitude, gnss_velocity[DOWN], ahrs_acceleration[DOWN]);
-
-      // 3d acceleration from the AHRS and from the vertical Kalman filter
-      float3vector acceleration = ahrs_acceleration;
-      // the vertical component comes from the Kalman Vario, effective value without gravitation
-      acceleration[DOWN] = KalmanVario_GNSS.get_x ( KalmanVario_PVA_t::ACCELERATION_OBSERVED);
-
-      // horizontal kalman filter for velocity and acceleration in the air- (not ground) system
-      Kalman_v_a_observer_N.update ( gnss_velocity[NORTH] - speed_compensator_wind[NORTH], ahrs_acceleration[NORTH]);
-      Kalman_v_a_observer_E.update ( gnss_velocity[EAST]  - speed_compensator_wind[EAST],  ahrs_acceleration[EAST]);
+      vario_uncompensated_GNSS = -KalmanVario_GNSS.get_x ( KalmanVario_PVA_t::VARIO);
 
       // compute our kinetic energy in the air-system
       specific_energy = (
@@ -77,41 +80,104 @@ void variometer_t::update_at_100Hz (
 	  + SQR( gnss_velocity[DOWN]))
 	  * ONE_DIV_BY_GRAVITY_TIMES_2;
 
-      // speed-compensation type 1 = scalar product( air_velocity , acceleration) / g;
-      speed_compensation_INS_GNSS_1 = ( gnss_velocity - speed_compensator_wind) * acceleration * RECIP_GRAVITY;
-
-      // speed compensation type 2 = air velocity * acceleration , both Kalman-filtered
-      speed_compensation_kalman_2 =
-	   (Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY) * Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION)
-	  + Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY) * Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION)
-	  + KalmanVario_GNSS.get_x (KalmanVario_PVA_t::VARIO) * KalmanVario_GNSS.get_x ( KalmanVario_PVA_t::ACCELERATION_OBSERVED))
-	  * RECIP_GRAVITY;
+      if( speed_compensation::USE_INS_GNSS || DEVELOPMENT_ADDITIONS)
+	{
+	  // 3d acceleration from the AHRS and from the vertical Kalman filter
+	  float3vector acceleration = ahrs_acceleration;
+	  // the vertical component comes from the Kalman Vario, effective value without gravitation
+	  acceleration[DOWN] = KalmanVario_GNSS.get_x ( KalmanVario_PVA_t::ACCELERATION_OBSERVED);
+
+	  // speed-compensation type 1 = scalar product( air_velocity , acceleration) / g;
+	  speed_compensation_INS_GNSS_1 = ( gnss_velocity - speed_compensator_wind) * acceleration * RECIP_GRAVITY;
+	}
+
+      if( speed_compensation::USE_KALMAN || DEVELOPMENT_ADDITIONS)
+	{
+	  // speed compensation type 2 = air velocity * acceleration , both Kalman-filtered
+	  speed_compensation_kalman_2 =
+	       (Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY) * Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION)
+	      + Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY) * Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION)
+	      + KalmanVario_GNSS.get_x (KalmanVario_PVA_t::VARIO) * KalmanVario_GNSS.get_x ( KalmanVario_PVA_t::ACCELERATION_OBSERVED))
+	      * RECIP_GRAVITY;
+	}
 
       // speed compensation type 3 comes from the derivative of the specific energy
       speed_compensation_energy_3 = specific_energy_differentiator.respond ( specific_energy);
 
-      // speed-compensation type 4 is the product of acceleration and velocity, both calculated along the heading axis
-      float3vector kalman_air_velocity;
-      kalman_air_velocity[NORTH] = Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY);
-      kalman_air_velocity[EAST]  = Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY);
-      kalman_air_velocity[DOWN]  = KalmanVario_GNSS.get_x (  	   KalmanVario_PVA_t::VARIO);
-      float air_velocity_projected = kalman_air_velocity * heading_vector;
-
-      acceleration[NORTH] = Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION);
-      acceleration[EAST]  = Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION);
-      acceleration[DOWN]  = KalmanVario_GNSS.get_x (	    KalmanVario_PVA_t::ACCELERATION_OBSERVED);
-      float acceleration_projected = acceleration * heading_vector;
-
-      speed_compensation_projected_4 = air_velocity_projected * acceleration_projected * RECIP_GRAVITY;
-
-      // blending of three mechanisms for speed-compensation
-      speed_compensation_GNSS = GNSS_INS_speedcomp_fusioner.respond( 0.3333333f * (speed_compensation_INS_GNSS_1 + speed_compensation_kalman_2 + speed_compensation_projected_4), speed_compensation_energy_3);
+      if( speed_compensation::USE_PROJECTED || DEVELOPMENT_ADDITIONS)
+	{
+	  // speed-compensation type 4 is the product of acceleration and velocity, both calculated along the heading axis
+	  float3vector kalman_air_velocity;
+	  kalman_air_velocity[NORTH] = Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY);
+	  kalman_air_velocity[EAST]  = Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::VELOCITY);
+	  kalman_air_velocity[DOWN]  = KalmanVario_GNSS.get_x (  	   KalmanVario_PVA_t::VARIO);
+	  float air_velocity_projected = kalman_air_velocity * heading_vector;
+
+	  float3vector acceleration;
+	  acceleration[NORTH] = Kalman_v_a_observer_N.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION);
+	  acceleration[EAST]  = Kalman_v_a_observer_E.get_x ( Kalman_V_A_Aoff_observer_t::ACCELERATION);
+	  acceleration[DOWN]  = KalmanVario_GNSS.get_x (	    KalmanVario_PVA_t::ACCELERATION_OBSERVED);
+	  float acceleration_projected = acceleration * heading_vector;
+
+	  speed_compensation_projected_4 = air_velocity_projected * acceleration_projected * RECIP_GRAVITY;
+	}
+
+      enum
+      {
+	INERTIAL_TYPES = speed_compensation::USE_INS_GNSS + speed_compensation::USE_KALMAN + speed_compensation::USE_PROJECTED
+      };
+
+      if( INERTIAL_TYPES == 0)
+	speed_compensation_GNSS = speed_compensation_energy_3;
+      else
+	{
+	  float inertial_speed_compensation =
+	      ( speed_compensation::USE_INS_GNSS  ? speed_compensation_INS_GNSS_1  : 0.0f)
+	    + ( speed_compensation::USE_KALMAN    ? speed_compensation_kalman_2    : 0.0f)
+	    + ( speed_compensation::USE_PROJECTED ? speed_compensation_projected_4 : 0.0f);
+	  inertial_speed_compensation *= INERTIAL_TYPES == 3 ? 0.3333333f : 1.0f / INERTIAL_TYPES;
+
+	  // blending of the inertial mechanisms with the energy derivative
+	  speed_compensation_GNSS = GNSS_INS_speedcomp_fusioner.respond( inertial_speed_compensation, speed_compensation_energy_3);
+	}
       vario_averager_GNSS.respond ( vario_uncompensated_GNSS + speed_compensation_GNSS);
     }
 }
 
 void variometer_t::reset(float pressure_negative_altitude, float GNSS_negative_altitude)
 {
-  KalmanVario_GNSS.reset( GNSS_negative_altitude, -9.81f);
-  KalmanVario_pressure.reset( pressure_negative_altitude, -9.81f);
+  KalmanVario_GNSS.set_x( KalmanVario_PVA_t::ALTITUDE, GNSS_negative_altitude);
+  KalmanVario_GNSS.set_x( KalmanVario_PVA_t::VARIO, 0.0f);
+  KalmanVario_GNSS.set_x( KalmanVario_PVA_t::ACCELERATION_OBSERVED, 0.0f);
+  KalmanVario_GNSS.set_x( KalmanVario_PVA_t::ACCELERATION_OFFSET, -9.81f);
+
+  KalmanVario_pressure.set_x( KalmanVario_t::ALTITUDE, pressure_negative_altitude);
+  KalmanVario_pressure.set_x( KalmanVario_t::VARIO, 0.0f);
+  KalmanVario_pressure.set_x( KalmanVario_t::ACCELERATION_OBSERVED, 0.0f);
+  KalmanVario_pressure.set_x( KalmanVario_t::ACCELERATION_OFFSET, -9.81f);
+}
+
+void variometer_t::update_at_100Hz (
+    const float3vector &gnss_velocity,
+    const float3vector &ahrs_acceleration,
+    const float3vector &heading_vector,
+    float GNSS_negative_altitude,
+    float pressure_altitude,
+    float IAS,
+    const float3vector &speed_compensator_wind,
+    bool GNSS_fix_avaliable
+  )
+{
+  update_at_100Hz< default_speed_compensation> ( gnss_velocity, ahrs_acceleration, heading_vector,
+      GNSS_negative_altitude, pressure_altitude, IAS, speed_compensator_wind, GNSS_fix_avaliable);
 }
+
+#if UNIX
+// all speed-compensation strategies, to be compared side by side on the host,
+// the target uses the default one only
+template void variometer_t::update_at_100Hz< blended_speed_compensation>( const float3vector &, const float3vector &, const float3vector &, float, float, float, const float3vector &, bool);
+template void variometer_t::update_at_100Hz< INS_GNSS_speed_compensation>( const float3vector &, const float3vector &, const float3vector &, float, float, float, const float3vector &, bool);
+template void variometer_t::update_at_100Hz< kalman_speed_compensation>( const float3vector &, const float3vector &, const float3vector &, float, float, float, const float3vector &, bool);
+template void variometer_t::update_at_100Hz< projected_speed_compensation>( const float3vector &, const float3vector &, const float3vector &, float, float, float, const float3vector &, bool);
+template void variometer_t::update_at_100Hz< energy_speed_compensation>( const float3vector &, const float3vector &, const float3vector &, float, float, float, const float3vector &, bool);
+#endif
@@ -32,6 +32,7 @@
 #include "KalmanVario.h"
 #include "KalmanVario_PVA.h"
 #include "Kalman_V_A_Aoff_observer.h"
+#include "steady_state_kalman_bank.h"
 #include "embedded_math.h"
 #include "NAV_tuning_parameters.h"
 #include "HP_LP_fusion.h"
@@ -44,6 +45,34 @@
 #include "HP_LP_fusion.h"
 #include "delay_line.h"
 
+/**
+ * @brief speed-compensation strategies, template parameter of variometer_t::update_at_100Hz()
+ *
+ * The derivative of the specific energy (type 3) is always the low-frequency part,
+ * the mean of the selected inertial types 1, 2 and 4 is the high-frequency part.
+ * Types not used by the strategy are only computed with DEVELOPMENT_ADDITIONS,
+ * to be reported in output_data_t::speed_compensation[].
+ */
+struct blended_speed_compensation	{ enum { USE_INS_GNSS = 1, USE_KALMAN = 1, USE_PROJECTED = 1 }; }; //!< types 1, 2 and 4
+struct INS_GNSS_speed_compensation	{ enum { USE_INS_GNSS = 1, USE_KALMAN = 0, USE_PROJECTED = 0 }; }; //!< type 1 only
+struct kalman_speed_compensation	{ enum { USE_INS_GNSS = 0, USE_KALMAN = 1, USE_PROJECTED = 0 }; }; //!< type 2 only
+struct projected_speed_compensation	{ enum { USE_INS_GNSS = 0, USE_KALMAN = 0, USE_PROJECTED = 1 }; }; //!< type 4 only
+struct energy_speed_compensation	{ enum { USE_INS_GNSS = 0, USE_KALMAN = 0, USE_PROJECTED = 0 }; }; //!< type 3 alone, no fusion
+
+typedef blended_speed_compensation default_speed_compensation;
+
+//! lanes of the variometer Kalman filter bank
+enum { PRESSURE_LANE, GNSS_LANE, NORTH_LANE, EAST_LANE};
+
+//! the four variometer Kalman filters, updated in one pass
+typedef steady_state_kalman_bank
+  <
+    KalmanVario_design< 100>,			// PRESSURE_LANE
+    KalmanVario_PVA_design< 100>,		// GNSS_LANE
+    Kalman_V_A_Aoff_observer_design< 100>,	// NORTH_LANE
+    Kalman_V_A_Aoff_observer_design< 100>	// EAST_LANE
+  > variometer_kalman_bank_t;
+
 //! this class is responsible for all glider flight data
 class variometer_t
 {
@@ -53,11 +82,12 @@ public:
     vario_averager_pressure( FAST_SAMPLING_TIME / configuration( VARIO_TC)),
     vario_averager_GNSS( FAST_SAMPLING_TIME / configuration( VARIO_TC)),
     kinetic_energy_differentiator( 1.0f, FAST_SAMPLING_TIME),
-    KalmanVario_GNSS( 0.0f, 0.0f, 0.0f, - GRAVITY),
-    KalmanVario_pressure( 0.0f, 0.0f, 0.0f, - GRAVITY),
+    kalman_bank(),
+    KalmanVario_GNSS( kalman_bank),
+    KalmanVario_pressure( kalman_bank),
     specific_energy_differentiator( 1.0f, FAST_SAMPLING_TIME),
-    Kalman_v_a_observer_N(),
-    Kalman_v_a_observer_E(),
+    Kalman_v_a_observer_N( kalman_bank),
+    Kalman_v_a_observer_E( kalman_bank),
     GNSS_INS_speedcomp_fusioner(SPEED_COMPENSATION_FUSIONER_FEEDBACK),
     vario_uncompensated_pressure( ZERO),
     speed_compensation_IAS( ZERO),
@@ -69,7 +99,25 @@ public:
     speed_compensation_energy_3(0.0f),
     speed_compensation_projected_4(0.0f)
   {
+    KalmanVario_GNSS.set_x( KalmanVario_PVA_t::ACCELERATION_OFFSET, - GRAVITY);
+    KalmanVario_pressure.set_x( KalmanVario_t::ACCELERATION_OFFSET, - GRAVITY);
   };
+  variometer_t( const variometer_t &) = delete; // the Kalman lanes refer to kalman_bank
+    //! update using the default speed-compensation strategy
+    void update_at_100Hz
+    (
+	const float3vector &gnss_velocity,
+	const float3vector &ahrs_acceleration,
+	const float3vector &heading_vector,
+	float GNSS_altitude,
+	float pressure_altitude,
+	float IAS,
+	const float3vector &wind_average,
+	bool GNSS_fix_avaliable
+    );
+
+    //! update using the given speed-compensation strategy
+    template< class speed_compensation>
     void update_at_100Hz
     (
 	const float3vector &gnss_velocity,
@@ -86,6 +134,7 @@ public:
 
     float get_pressure_altitude( void) const;
 
+  //! types 1 .. 4, the types not used by the strategy only with DEVELOPMENT_ADDITIONS
   float
   get_speed_compensation (unsigned index) const
   {
@@ -148,11 +197,12 @@ private:
 	pt2<float,float> vario_averager_pressure;
 	pt2<float,float> vario_averager_GNSS;
 	differentiator<float,float>kinetic_energy_differentiator;
-	KalmanVario_PVA_t KalmanVario_GNSS;
-	KalmanVario_t KalmanVario_pressure;
+	variometer_kalman_bank_t kalman_bank;
+	steady_state_kalman_lane< variometer_kalman_bank_t, GNSS_LANE> KalmanVario_GNSS;
+	steady_state_kalman_lane< variometer_kalman_bank_t, PRESSURE_LANE> KalmanVario_pressure;
 	differentiator<float,float>specific_energy_differentiator;
-	Kalman_V_A_Aoff_observer_t Kalman_v_a_observer_N;
-	Kalman_V_A_Aoff_observer_t Kalman_v_a_observer_E;
+	steady_state_kalman_lane< variometer_kalman_bank_t, NORTH_LANE> Kalman_v_a_observer_N;
+	steady_state_kalman_lane< variometer_kalman_bank_t, EAST_LANE> Kalman_v_a_observer_E;
 	HP_LP_fusion <float, float> GNSS_INS_speedcomp_fusioner;
 
 	// variometer-related signals
@@ -27,6 +27,7 @@
 #include "CAN_output.h"
 #include "data_structures.h"
 #include "system_state.h"
+#include "stage_profiler.h"
 
 #define DEGREE_2_RAD 1.7453292e-2f
 
@@ -200,6 +201,7 @@ enum CAN_ID_SENSOR
   CAN_Id_TurnRate	= 0x40d,    //!< float turn rate to the right, (uint8_t) (enum  { STRAIGHT_FLIGHT, TRANSITION, CIRCLING} )
   CAN_Id_SystemState	= 0x40e,    //!< u32 system_state, u32 git_tag_dec
   CAN_Id_Voltage	= 0x40f,    //!< float supply voltage
+  CAN_Id_Stage_Timing	= 0x410,    //!< u32 stage << 24 | min cycles (24 bit), u32 max cycles
 };
 
 void CAN_output ( const output_data_t &x)
@@ -314,5 +316,22 @@ void CAN_output ( const output_data_t &x)
   CAN_send(p, 1);
 }
 
+#if STAGE_PROFILING
+void CAN_output_stage_timing( void)
+{
+  static unsigned stage = 0;
+  const stage_statistics_t & s = get_stage_statistics( (profiled_stage_t)stage);
+
+  CANpacket p;
+  p.id=CAN_Id_Stage_Timing;
+  p.dlc=8;
+  p.data_w[0] = (stage << 24) | (s.min > 0xffffff ? 0xffffff : s.min);
+  p.data_w[1] = s.max;
+  CAN_send(p, 1);
+
+  if( ++stage >= PROFILE_STAGES_END)
+    stage = 0;
+}
+#endif
 
 #endif
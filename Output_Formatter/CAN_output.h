@@ -26,7 +26,15 @@
 #define SRC_CAN_OUTPUT_H_
 
 #include "data_structures.h"
+#include "stage_profiler.h"
 
 void CAN_output ( const output_data_t &x, bool horizon_activated);
 
+#if STAGE_PROFILING
+void CAN_output_stage_timing( void); //!< one profiled stage per call, round-robin
+#else
+inline void CAN_output_stage_timing( void) //!< nothing to report without STAGE_PROFILING
+{}
+#endif
+
 #endif /* SRC_CAN_OUTPUT_H_ */
@@ -0,0 +1,291 @@
+/***********************************************************************//**
+ * @file		flight_generator.cpp
+ * @brief		synthetic flight data for deterministic load tests
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "flight_generator.h"
+#include "quaternion.h"
+#include "NAV_tuning_parameters.h"
+#include <math.h>
+
+#define SAMPLING_TIME 0.01f
+#define METER_PER_DEGREE_LATITUDE 111132.95
+#define METER_PER_DEGREE_LONGITUDE_AT_EQUATOR 111319.49
+#define GROUND_ROLL_DECELERATION 1.5f	//!< m/s^2
+#define VERTICAL_SPEED_TIME_CONSTANT 2.0f 	//!< s
+
+flight_generator_parameters_t default_flight_generator_parameters( void)
+{
+  flight_generator_parameters_t p;
+  p.TAS = 25.0f;
+  p.wind[NORTH] = 0.0f;
+  p.wind[EAST] = 5.0f; // westerly wind
+  p.wind[DOWN] = 0.0f;
+  p.start_altitude = 1000.0f;
+  p.ground_altitude = 200.0f;
+  p.latitude = 50.0;
+  p.longitude = 8.0;
+  p.inclination = 65.0f;
+  p.declination = 3.0f;
+  p.D_GNSS = true;
+  p.acc_noise = 0.05f;
+  p.gyro_noise = 0.002f;
+  p.mag_noise = 0.005f;
+  p.pressure_noise = 2.0f;
+  p.seed = 1;
+  return p;
+}
+
+flight_generator_t::flight_generator_t( const flight_generator_parameters_t & _parameters, const std::vector< flight_segment_t> & _segments)
+: parameters( _parameters),
+  segments( _segments),
+  buffer( BLOCK_SIZE),
+  total_samples( 0),
+  sample( 0),
+  segment( 0),
+  segment_end( 0),
+  random_state( _parameters.seed ? _parameters.seed : 1), // xorshift must not start at zero
+  heading( 0.0f),
+  TAS( _parameters.TAS),
+  position(),
+  vertical_speed( 0.0f),
+  landed( false)
+{
+  for( unsigned i = 0; i < segments.size(); ++i)
+    total_samples += (size_t)( segments[i].duration / SAMPLING_TIME);
+  if( ! segments.empty())
+    segment_end = (size_t)( segments[0].duration / SAMPLING_TIME);
+
+  float inclination = parameters.inclination * M_PI_F / 180.0f;
+  float declination = parameters.declination * M_PI_F / 180.0f;
+  expected_induction[NORTH] = COS( inclination) * COS( declination);
+  expected_induction[EAST]  = COS( inclination) * SIN( declination);
+  expected_induction[DOWN]  = SIN( inclination);
+}
+
+std::vector< flight_segment_t> flight_generator_t::cross_country_flight( float duration, bool with_landing)
+{
+  std::vector< flight_segment_t> plan;
+  const float landing_time = 600.0f;
+  float remaining = with_landing ? duration - landing_time : duration;
+  bool right_turn = true;
+
+  while( remaining > 0.0f)
+    {
+      flight_segment_t glide = { SEGMENT_STRAIGHT, 120.0f, 0.0f, -1.0f};
+      flight_segment_t thermal = { SEGMENT_CIRCLING, 90.0f, right_turn ? 0.2f : -0.2f, 1.5f};
+      right_turn = ! right_turn;
+
+      glide.duration = glide.duration < remaining ? glide.duration : remaining;
+      plan.push_back( glide);
+      remaining -= glide.duration;
+      if( remaining <= 0.0f)
+	break;
+
+      thermal.duration = thermal.duration < remaining ? thermal.duration : remaining;
+      plan.push_back( thermal);
+      remaining -= thermal.duration;
+    }
+
+  if( with_landing)
+    {
+      flight_segment_t landing = { SEGMENT_LANDING, duration < landing_time ? duration : landing_time, 0.0f, 0.0f};
+      plan.push_back( landing);
+    }
+  return plan;
+}
+
+//! uniform noise in { -peak, +peak }, xorshift32
+float flight_generator_t::noise( float peak)
+{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return peak * ( (float)( random_state >> 8) * (2.0f / 16777216.0f) - 1.0f);
+}
+
+size_t flight_generator_t::next_block( const observations_type * &block)
+{
+  size_t count = total_samples - sample;
+  if( count > BLOCK_SIZE)
+    count = BLOCK_SIZE;
+
+  for( size_t i = 0; i < count; ++i)
+    generate( buffer[i]);
+
+  block = buffer.data();
+  return count;
+}
+
+void flight_generator_t::generate( observations_type & o)
+{
+  while( (sample >= segment_end) && (segment + 1 < segments.size()))
+    {
+      ++segment;
+      segment_end += (size_t)( segments[segment].duration / SAMPLING_TIME);
+    }
+  const flight_segment_t & s = segments[segment];
+
+  float turn_rate = 0.0f;
+  float target_vertical_speed = - s.climb_rate;
+  float TAS_derivative = 0.0f;
+  float height_above_ground = parameters.start_altitude - position[DOWN] - parameters.ground_altitude;
+
+  switch( s.type)
+    {
+    case SEGMENT_CIRCLING:
+      turn_rate = s.turn_rate;
+      break;
+    case SEGMENT_LANDING:
+      if( ! landed && height_above_ground <= 0.0f)
+	landed = true;
+      // final glide with a smooth flare
+      target_vertical_speed = 0.5f + 0.05f * height_above_ground;
+      if( target_vertical_speed > 5.0f)
+	target_vertical_speed = 5.0f;
+      break;
+    case SEGMENT_STRAIGHT:
+    default:
+      break;
+    }
+
+  float vertical_acceleration = 0.0f;
+  if( landed)
+    {
+      position[DOWN] = parameters.start_altitude - parameters.ground_altitude;
+      vertical_speed = 0.0f;
+      if( TAS > 0.0f)
+	{
+	  TAS_derivative = - GROUND_ROLL_DECELERATION;
+	  TAS += TAS_derivative * SAMPLING_TIME;
+	  if( TAS < 0.0f)
+	    {
+	      TAS = 0.0f;
+	      TAS_derivative = 0.0f;
+	    }
+	}
+    }
+  else
+    {
+      vertical_acceleration = (target_vertical_speed - vertical_speed) / VERTICAL_SPEED_TIME_CONSTANT;
+      vertical_speed += vertical_acceleration * SAMPLING_TIME;
+    }
+
+  heading += turn_rate * SAMPLING_TIME;
+  if( heading > M_PI_F)
+    heading -= 2.0f * M_PI_F;
+  if( heading < -M_PI_F)
+    heading += 2.0f * M_PI_F;
+
+  float sin_heading = SIN( heading);
+  float cos_heading = COS( heading);
+
+  float3vector velocity;
+  velocity[NORTH] = TAS * cos_heading;
+  velocity[EAST]  = TAS * sin_heading;
+  velocity[DOWN]  = vertical_speed;
+  if( ! landed) // drifting with the air mass
+    {
+      velocity[NORTH] += parameters.wind[NORTH];
+      velocity[EAST]  += parameters.wind[EAST];
+    }
+  position += velocity * SAMPLING_TIME;
+
+  float3vector acceleration;
+  acceleration[NORTH] = - turn_rate * TAS * sin_heading + TAS_derivative * cos_heading;
+  acceleration[EAST]  =   turn_rate * TAS * cos_heading + TAS_derivative * sin_heading;
+  acceleration[DOWN]  = vertical_acceleration;
+
+  // coordinated flight: bank angle from centripetal acceleration
+  quaternion<float> attitude;
+  attitude.from_euler( ATAN2( turn_rate * TAS, GRAVITY), 0.0f, heading);
+  float3matrix body2nav;
+  attitude.get_rotation_matrix( body2nav);
+
+  float3vector specific_force = acceleration;
+  specific_force[DOWN] -= GRAVITY;
+  float3vector nav_rotation;
+  nav_rotation[DOWN] = turn_rate;
+
+  o = observations_type{};
+
+  o.m.acc  = body2nav.reverse_map( specific_force);
+  o.m.gyro = body2nav.reverse_map( nav_rotation);
+  o.m.mag  = body2nav.reverse_map( expected_induction);
+  for( unsigned i = 0; i < 3; ++i)
+    {
+      o.m.acc[i]  += noise( parameters.acc_noise);
+      o.m.gyro[i] += noise( parameters.gyro_noise);
+      o.m.mag[i]  += noise( parameters.mag_noise);
+    }
+
+  // ICAO standard atmosphere
+  float altitude = parameters.start_altitude - position[DOWN];
+  float temperature = 288.15f - 0.0065f * altitude;
+  float pressure = 101325.0f * powf( 1.0f - 2.25577e-5f * altitude, 5.25588f);
+  float density = pressure / ( 287.058f * temperature);
+
+  o.m.static_pressure = pressure + noise( parameters.pressure_noise);
+  o.m.pitot_pressure = 0.5f * density * TAS * TAS + noise( parameters.pressure_noise);
+  o.m.static_sensor_temperature = 20.0f;
+  o.m.supply_voltage = 12.5f;
+#if WITH_DENSITY_DATA
+  o.m.outside_air_temperature = temperature - 273.15f;
+  o.m.outside_air_humidity = 0.5f;
+#endif
+
+  o.c.position = position;
+  o.c.velocity = velocity;
+  o.c.acceleration = acceleration;
+  float track = ATAN2( velocity[EAST], velocity[NORTH]) * 180.0f / M_PI_F;
+  o.c.heading_motion = track < 0.0f ? track + 360.0f : track;
+  o.c.speed_motion = SQRT( SQR( velocity[NORTH]) + SQR( velocity[EAST]));
+  o.c.speed_acc = 0.2f;
+  o.c.latitude  = parameters.latitude + position[NORTH] / METER_PER_DEGREE_LATITUDE;
+  o.c.longitude = parameters.longitude + position[EAST]
+      / ( METER_PER_DEGREE_LONGITUDE_AT_EQUATOR * cos( parameters.latitude * M_PI / 180.0));
+
+  if( parameters.D_GNSS)
+    {
+      o.c.relPosNED[NORTH] = cos_heading; // 1m base line along the fuselage
+      o.c.relPosNED[EAST]  = sin_heading;
+      o.c.relPosHeading = heading;
+      o.c.sat_fix_type = SAT_FIX | SAT_HEADING;
+    }
+  else
+    o.c.sat_fix_type = SAT_FIX;
+
+  size_t seconds = sample / 100 + 10 * 3600; // start at 10:00 UTC
+  o.c.year = 24;
+  o.c.month = 6;
+  o.c.day = 1 + seconds / 86400 % 28;
+  o.c.hour = seconds / 3600 % 24;
+  o.c.minute = seconds / 60 % 60;
+  o.c.second = seconds % 60;
+#if INCLUDING_NANO
+  o.c.nano = (sample % 100) * 10000000;
+#endif
+  o.c.SATS_number = 14;
+  o.c.geo_sep_dm = 480;
+
+  ++sample;
+}
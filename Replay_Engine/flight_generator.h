@@ -0,0 +1,120 @@
+/***********************************************************************//**
+ * @file		flight_generator.h
+ * @brief		synthetic flight data for deterministic load tests
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef FLIGHT_GENERATOR_H_
+#define FLIGHT_GENERATOR_H_
+
+#include <stdint.h>
+#include <vector>
+#include "system_configuration.h"
+#include "data_structures.h"
+#include "flight_replay.h"
+
+enum flight_segment_type
+{
+  SEGMENT_STRAIGHT,	//!< straight glide
+  SEGMENT_CIRCLING,	//!< thermalling circles
+  SEGMENT_LANDING	//!< final glide, ground roll and standstill
+};
+
+//! one part of a synthetic flight
+typedef struct
+{
+  flight_segment_type type;
+  float duration;	//!< seconds
+  float turn_rate;	//!< rad/s, positive = right turn, circling only
+  float climb_rate;	//!< m/s, negative = sinking
+} flight_segment_t;
+
+//! environment and sensor parameters of a synthetic flight
+typedef struct
+{
+  float TAS;			//!< true airspeed m/s
+  float3vector wind;		//!< NED m/s, direction where the air moves to
+  float start_altitude;		//!< MSL m
+  float ground_altitude;	//!< MSL m, used by the landing
+  double latitude;		//!< start position / degrees
+  double longitude;
+  float inclination;		//!< magnetic field / degrees
+  float declination;
+  bool D_GNSS;			//!< SAT_HEADING available
+  float acc_noise;		//!< m/s^2 peak
+  float gyro_noise;		//!< rad/s peak
+  float mag_noise;		//!< peak
+  float pressure_noise;		//!< Pa peak
+  uint32_t seed;		//!< noise generator seed, same seed = same flight
+} flight_generator_parameters_t;
+
+//! some typical gliding conditions in central Europe
+flight_generator_parameters_t default_flight_generator_parameters( void);
+
+/**
+ * @brief observation source computing a synthetic flight on the fly
+ *
+ * Coordinated flight with constant TAS in a horizontally moving air mass.
+ * Sensor readings are consistent with the trajectory, optionally with
+ * deterministic noise. The data are produced block by block into an
+ * internal buffer, so arbitrary long flights need constant memory.
+ */
+class flight_generator_t : public observation_source_t
+{
+public:
+  enum { BLOCK_SIZE = 4096 };
+
+  flight_generator_t( const flight_generator_parameters_t & _parameters, const std::vector< flight_segment_t> & _segments);
+
+  size_t next_block( const observations_type * &block);
+
+  //! number of 10ms samples of the complete flight
+  size_t get_total_samples( void) const
+  {
+    return total_samples;
+  }
+
+  //! create a flight of the given length: alternating straight glides and circles, optionally landing
+  static std::vector< flight_segment_t> cross_country_flight( float duration, bool with_landing);
+
+private:
+  void generate( observations_type & o);
+  float noise( float peak);
+
+  flight_generator_parameters_t parameters;
+  std::vector< flight_segment_t> segments;
+  std::vector< observations_type> buffer;
+  size_t total_samples;
+  size_t sample;	//!< samples generated so far
+  unsigned segment;	//!< present segment
+  size_t segment_end;	//!< first sample of the next segment
+  uint32_t random_state;
+
+  // trajectory state
+  float heading;	//!< rad
+  float TAS;
+  float3vector position;	//!< NED relative to start, m
+  float vertical_speed;	//!< DOWN, m/s
+  bool landed;
+  float3vector expected_induction; //!< NED
+};
+
+#endif /* FLIGHT_GENERATOR_H_ */
@@ -0,0 +1,134 @@
+/***********************************************************************//**
+ * @file		flight_log_reader.cpp
+ * @brief		zero-copy access to recorded flight logs using memory mapping
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "flight_log_reader.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+flight_log_header_t make_flight_log_header( void)
+{
+  flight_log_header_t header;
+  header.magic = FLIGHT_LOG_MAGIC;
+  header.version = FLIGHT_LOG_VERSION;
+  header.header_size = sizeof( flight_log_header_t);
+  header.record_size = sizeof( observations_type);
+  header.variant = 0
+#if WITH_LOWCOST_SENSORS
+      | LOG_WITH_LOWCOST_SENSORS
+#endif
+#if WITH_DENSITY_DATA
+      | LOG_WITH_DENSITY_DATA
+#endif
+#if INCLUDING_NANO
+      | LOG_INCLUDING_NANO
+#endif
+#if WITH_DENSITY_DUMMY
+      | LOG_WITH_DENSITY_DUMMY
+#endif
+      ;
+  return header;
+}
+
+bool flight_log_reader_t::open( const char * path)
+{
+  close();
+
+  int fd = ::open( path, O_RDONLY);
+  if( fd < 0)
+    return true;
+
+  struct stat status;
+  if( fstat( fd, &status) != 0 || status.st_size == 0)
+    {
+      ::close( fd);
+      return true;
+    }
+
+  mapping_size = status.st_size;
+  mapping = mmap( 0, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close( fd); // the mapping keeps the file referenced
+  if( mapping == MAP_FAILED)
+    {
+      mapping = 0;
+      mapping_size = 0;
+      return true;
+    }
+
+  // we read the file once from front to back
+  madvise( mapping, mapping_size, MADV_SEQUENTIAL);
+  madvise( mapping, mapping_size, MADV_WILLNEED);
+
+  const char * data = (const char *) mapping;
+  size_t payload = mapping_size;
+  const flight_log_header_t * header = (const flight_log_header_t *) data;
+
+  if( mapping_size >= sizeof( flight_log_header_t) && header->magic == FLIGHT_LOG_MAGIC)
+    {
+      flight_log_header_t expected = make_flight_log_header();
+      if(    header->version != FLIGHT_LOG_VERSION
+	  || header->record_size != expected.record_size
+	  || header->variant != expected.variant
+	  || header->header_size < sizeof( flight_log_header_t)
+	  || header->header_size > mapping_size)
+	{
+	  close();
+	  return true; // recorded by an incompatible firmware variant
+	}
+      data += header->header_size;
+      payload -= header->header_size;
+    }
+
+  if( payload % sizeof( observations_type) != 0)
+    {
+      close();
+      return true; // truncated or not a flight log at all
+    }
+
+  records = (const observations_type *) data;
+  record_count = payload / sizeof( observations_type);
+  delivered = false;
+  return false;
+}
+
+void flight_log_reader_t::close( void)
+{
+  if( mapping)
+    munmap( mapping, mapping_size);
+  mapping = 0;
+  mapping_size = 0;
+  records = 0;
+  record_count = 0;
+  delivered = false;
+}
+
+size_t flight_log_reader_t::next_block( const observations_type * &block)
+{
+  if( delivered)
+    return 0;
+  delivered = true;
+  block = records;
+  return record_count;
+}
@@ -0,0 +1,118 @@
+/***********************************************************************//**
+ * @file		flight_log_reader.h
+ * @brief		zero-copy access to recorded flight logs using memory mapping
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef FLIGHT_LOG_READER_H_
+#define FLIGHT_LOG_READER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "system_configuration.h"
+#include "data_structures.h"
+#include "flight_replay.h"
+
+enum flight_log_variant_flags
+{
+  LOG_WITH_LOWCOST_SENSORS	= 1,
+  LOG_WITH_DENSITY_DATA		= 2,
+  LOG_INCLUDING_NANO		= 4,
+  LOG_WITH_DENSITY_DUMMY	= 8
+};
+
+#define FLIGHT_LOG_MAGIC 0x5355524c // "LRUS" little endian
+#define FLIGHT_LOG_VERSION 1
+
+#pragma pack(push, 1)
+
+//! optional header in front of the fixed-size observation records
+typedef struct
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size; 	//!< offset of the first record in bytes
+  uint32_t record_size; 	//!< sizeof( observations_type) of the recording firmware
+  uint32_t variant;		//!< @ref flight_log_variant_flags of the recording firmware
+} flight_log_header_t;
+
+#pragma pack(pop)
+
+//! header describing the observations_type layout of this build
+flight_log_header_t make_flight_log_header( void);
+
+/**
+ * @brief read-only memory mapping of a recorded flight log
+ *
+ * The records are used in place, no per-sample read or copy takes place.
+ * Files with a header are checked against the record layout of this build,
+ * raw files without header are accepted if their size is a multiple of the
+ * record size.
+ */
+class flight_log_reader_t : public observation_source_t
+{
+public:
+  flight_log_reader_t( void)
+  : mapping( 0),
+    mapping_size( 0),
+    records( 0),
+    record_count( 0),
+    delivered( false)
+  {}
+  ~flight_log_reader_t( void)
+  {
+    close();
+  }
+
+  //! map the file, @return true on error
+  bool open( const char * path);
+  void close( void);
+
+  const observations_type * get_records( void) const
+  {
+    return records;
+  }
+  size_t get_record_count( void) const
+  {
+    return record_count;
+  }
+
+  //! the complete file is delivered as one block
+  size_t next_block( const observations_type * &block);
+
+  //! start from the first record again
+  void rewind( void)
+  {
+    delivered = false;
+  }
+
+private:
+  flight_log_reader_t( const flight_log_reader_t &); // not copyable
+  flight_log_reader_t & operator = ( const flight_log_reader_t &);
+
+  void * mapping;
+  size_t mapping_size;
+  const observations_type * records;
+  size_t record_count;
+  bool delivered;
+};
+
+#endif /* FLIGHT_LOG_READER_H_ */
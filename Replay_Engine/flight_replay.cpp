@@ -0,0 +1,89 @@
+/***********************************************************************//**
+ * @file		flight_replay.cpp
+ * @brief		replay recorded flights through the organizer, many flights in parallel
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "system_configuration.h"
+#include "flight_replay.h"
+#include "organizer.h"
+
+void flight_replay_t::run( void)
+{
+  configuration_scope_t scope( configuration);
+
+  organizer_t organizer; // reads its parameters from our flight configuration
+  output_data_t output_data = { };
+  unsigned slow_tick_counter = 0;
+  unsigned output_tick_counter = 0;
+  const observations_type *block;
+  size_t block_size;
+
+  organizer.initialize_before_measurement();
+  organizer.register_background_task(); // we call it ourselves, see below
+
+  while( (block_size = source.next_block( block)) != 0)
+    for( const observations_type *record = block; record < block + block_size; )
+      {
+	size_t burst = 1;
+
+	if( samples == 0)
+	  {
+	    output_data.m = record->m;
+	    output_data.c = record->c;
+	    organizer.initialize_after_first_measurement( output_data);
+	    if( output_data.c.sat_fix_type & SAT_FIX)
+	      organizer.update_magnetic_induction_data( output_data.c.latitude, output_data.c.longitude);
+	  }
+	else // run up to the next slow path tick or output record
+	  {
+	    burst = block + block_size - record;
+	    if( burst > 10 - slow_tick_counter)
+	      burst = 10 - slow_tick_counter;
+	    if( burst > output_decimation - output_tick_counter)
+	      burst = output_decimation - output_tick_counter;
+	  }
+
+	organizer.update_block( record, burst, output_data);
+	organizer.process_background_tasks(); // synchronous for reproducible results
+	record += burst;
+	samples += burst;
+	slow_tick_counter += burst;
+	output_tick_counter += burst;
+
+	if( slow_tick_counter >= 10) // 10 Hz slow path
+	  {
+	    slow_tick_counter = 0;
+#if WITH_DENSITY_DATA
+	    organizer.set_density_data( output_data.m.outside_air_temperature, output_data.m.outside_air_humidity);
+#endif
+	    if( organizer.update_every_100ms( output_data))
+	      ++landings;
+	  }
+
+	if( output_tick_counter >= output_decimation)
+	  {
+	    output_tick_counter = 0;
+	    organizer.report_data( output_data);
+	    sink.consume( output_data);
+	  }
+      }
+}
@@ -0,0 +1,170 @@
+/***********************************************************************//**
+ * @file		flight_replay.h
+ * @brief		replay recorded flights through the organizer, many flights in parallel
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef FLIGHT_REPLAY_H_
+#define FLIGHT_REPLAY_H_
+
+#include <stddef.h>
+#include <vector>
+#include "data_structures.h"
+#include "replay_configuration.h"
+#include "work_stealing_pool.h"
+
+//! supplier of recorded observations, delivering contiguous blocks of records
+class observation_source_t
+{
+public:
+  virtual ~observation_source_t( void)
+  {}
+  /**
+   * @brief get the next block of records
+   * @param block is set to the first record, valid until the next call
+   * @return number of records in the block, 0 at the end of the data
+   */
+  virtual size_t next_block( const observations_type * &block) = 0;
+};
+
+//! observations kept in memory (or some mapped file)
+class observation_array_t : public observation_source_t
+{
+public:
+  observation_array_t( const observations_type *_data, size_t _count)
+  : data( _data),
+    count( _count)
+  {}
+  size_t next_block( const observations_type * &block)
+  {
+    block = data;
+    size_t retv = count;
+    data += count;
+    count = 0;
+    return retv;
+  }
+private:
+  const observations_type *data;
+  size_t count;
+};
+
+//! receiver of the organizer output, one record every 10ms
+class output_sink_t
+{
+public:
+  virtual ~output_sink_t( void)
+  {}
+  virtual void consume( const output_data_t &data) = 0;
+};
+
+//! keep all output data in memory
+class output_recorder_t : public output_sink_t
+{
+public:
+  void consume( const output_data_t &data)
+  {
+    recording.push_back( data);
+  }
+  std::vector< output_data_t> recording;
+};
+
+/**
+ * @brief one recorded flight replayed through its own organizer_t instance
+ *
+ * The organizer is created inside run() with the flight configuration bound
+ * to the executing thread, so flights do not share any mutable state.
+ */
+class flight_replay_t
+{
+public:
+  flight_replay_t( observation_source_t &_source, output_sink_t &_sink, flight_configuration_t &_configuration)
+  : source( _source),
+    sink( _sink),
+    configuration( _configuration),
+    output_decimation( 1),
+    samples( 0),
+    landings( 0)
+  {}
+
+  void run( void); //!< replay the complete flight on the calling thread
+
+  /**
+   * @brief deliver only every n-th output record to the sink
+   *
+   * The records in between are processed in bursts using
+   * organizer_t::update_block() without assembling their output.
+   * The delivered records are identical to those of a full replay.
+   */
+  void set_output_decimation( unsigned n)
+  {
+    output_decimation = n > 0 ? n : 1;
+  }
+
+  size_t get_samples( void) const
+  {
+    return samples;
+  }
+  unsigned get_landings( void) const
+  {
+    return landings;
+  }
+
+private:
+  observation_source_t &source;
+  output_sink_t &sink;
+  flight_configuration_t &configuration;
+  unsigned output_decimation;	//!< one output record every n samples
+  size_t samples;	//!< number of 10ms records processed
+  unsigned landings;	//!< number of landings reported by the organizer
+};
+
+//! schedule any number of flight replays across all cores
+class replay_engine_t
+{
+public:
+  //! @param threads number of worker threads, 0 = one per hardware thread
+  explicit replay_engine_t( unsigned threads = 0)
+  : pool( threads)
+  {}
+
+  //! start replaying this flight, the object must live until wait() returns
+  void add_flight( flight_replay_t &flight)
+  {
+    flight_replay_t *job = &flight;
+    pool.submit( [job]{ job->run(); });
+  }
+
+  //! block until all flights added so far are finished
+  void wait( void)
+  {
+    pool.wait_idle();
+  }
+
+  unsigned get_thread_count( void) const
+  {
+    return pool.get_thread_count();
+  }
+
+private:
+  work_stealing_pool_t pool;
+};
+
+#endif /* FLIGHT_REPLAY_H_ */
@@ -0,0 +1,48 @@
+/***********************************************************************//**
+ * @file		induction_annotator.cpp
+ * @brief		expected magnetic declination and inclination for large position arrays
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "induction_annotator.h"
+
+void induction_annotator_t::annotate( const double * latitude, const double * longitude, size_t count,
+				      float * declination, float * inclination)
+{
+  if( count <= INDUCTION_ANNOTATOR_JOB_SIZE)
+    {
+      earth_induction_grid.get_induction_data_at( latitude, longitude, (unsigned)count,
+						  declination, inclination);
+      return;
+    }
+
+  for( size_t start = 0; start < count; start += INDUCTION_ANNOTATOR_JOB_SIZE)
+    {
+      unsigned size = (unsigned)( count - start < INDUCTION_ANNOTATOR_JOB_SIZE
+				  ? count - start : INDUCTION_ANNOTATOR_JOB_SIZE);
+      pool.submit( [=]
+	{
+	  earth_induction_grid.get_induction_data_at( latitude + start, longitude + start, size,
+						      declination + start, inclination + start);
+	});
+    }
+  pool.wait_idle();
+}
@@ -0,0 +1,63 @@
+/***********************************************************************//**
+ * @file		induction_annotator.h
+ * @brief		expected magnetic declination and inclination for large position arrays
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef INDUCTION_ANNOTATOR_H_
+#define INDUCTION_ANNOTATOR_H_
+
+#include "earth_induction_grid.h"
+#include "work_stealing_pool.h"
+#include <stddef.h>
+
+#define INDUCTION_ANNOTATOR_JOB_SIZE 65536 //!< positions per pool task
+
+/**
+ * @brief annotate log archives with the earth induction model, all cores
+ *
+ * The input is split into jobs of INDUCTION_ANNOTATOR_JOB_SIZE positions,
+ * each job uses the batch lookup of earth_induction_grid_t,
+ * the same model the firmware uses in flight.
+ * Small inputs are processed by the calling thread.
+ */
+class induction_annotator_t
+{
+public:
+  //! @param threads number of worker threads, 0 = one per hardware thread
+  explicit induction_annotator_t( unsigned threads = 0)
+  : pool( threads)
+  {}
+
+  //! structure of arrays in and out, blocks until all positions are done
+  void annotate( const double * latitude, const double * longitude, size_t count,
+		 float * declination, float * inclination);
+
+  unsigned get_thread_count( void) const
+  {
+    return pool.get_thread_count();
+  }
+
+private:
+  work_stealing_pool_t pool;
+};
+
+#endif /* INDUCTION_ANNOTATOR_H_ */
@@ -0,0 +1,110 @@
+/***********************************************************************//**
+ * @file		legacy_log_converter.cpp
+ * @brief		streaming conversion of legacy flight logs into the current record layout
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "legacy_log_converter.h"
+#include <stddef.h>
+#include <sys/stat.h>
+
+void convert_legacy_records( observations_type * out, const old_input_data_t * in, size_t count)
+{
+  for( size_t i = 0; i < count; ++i)
+    {
+      out[i] = observations_type{};
+      new_format_from_old( out[i].m, out[i].c, in[i]);
+    }
+}
+
+legacy_log_converter_t::legacy_log_converter_t( void)
+: input( 0),
+  input_count( 0),
+  file( 0),
+  file_buffer( 0),
+  output_buffer( new observations_type[CHUNK_SIZE])
+{}
+
+legacy_log_converter_t::legacy_log_converter_t( const old_input_data_t * data, size_t count)
+: input( data),
+  input_count( count),
+  file( 0),
+  file_buffer( 0),
+  output_buffer( new observations_type[CHUNK_SIZE])
+{}
+
+legacy_log_converter_t::~legacy_log_converter_t( void)
+{
+  if( file)
+    fclose( file);
+  delete [] file_buffer;
+  delete [] output_buffer;
+}
+
+bool legacy_log_converter_t::open( const char * path)
+{
+  if( file)
+    fclose( file);
+  file = fopen( path, "rb");
+  if( file == 0)
+    return true;
+
+  struct stat status;
+  if( fstat( fileno( file), &status) != 0 || status.st_size == 0
+      || status.st_size % sizeof( old_input_data_t) != 0)
+    {
+      fclose( file);
+      file = 0;
+      return true; // truncated or not a legacy log at all
+    }
+
+  if( file_buffer == 0)
+    file_buffer = new old_input_data_t[CHUNK_SIZE];
+  input = 0;
+  input_count = 0;
+  return false;
+}
+
+size_t legacy_log_converter_t::next_block( const observations_type * &block)
+{
+  const old_input_data_t * source;
+  size_t count;
+
+  if( file)
+    {
+      count = fread( file_buffer, sizeof( old_input_data_t), CHUNK_SIZE, file);
+      source = file_buffer;
+    }
+  else
+    {
+      count = input_count < CHUNK_SIZE ? input_count : (size_t)CHUNK_SIZE;
+      source = input;
+      input += count;
+      input_count -= count;
+    }
+
+  if( count == 0)
+    return 0;
+
+  convert_legacy_records( output_buffer, source, count);
+  block = output_buffer;
+  return count;
+}
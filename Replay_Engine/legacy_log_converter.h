@@ -0,0 +1,74 @@
+/***********************************************************************//**
+ * @file		legacy_log_converter.h
+ * @brief		streaming conversion of legacy flight logs into the current record layout
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef LEGACY_LOG_CONVERTER_H_
+#define LEGACY_LOG_CONVERTER_H_
+
+#include <stdio.h>
+#include "system_configuration.h"
+#include "old_data_structures.h"
+#include "flight_replay.h"
+
+/**
+ * @brief convert a block of legacy records into the current layout
+ *
+ * new_format_from_old() on every record.
+ * Fields not present in the legacy layout are set to zero.
+ */
+void convert_legacy_records( observations_type * out, const old_input_data_t * in, size_t count);
+
+/**
+ * @brief observation source delivering legacy logs in the current layout
+ *
+ * Input is either a block of legacy records in memory (or mapped)
+ * or a file that is read in chunks.
+ * Output is converted chunk by chunk into an internal buffer,
+ * so a replay can use a legacy log without an intermediate file.
+ */
+class legacy_log_converter_t : public observation_source_t
+{
+public:
+  enum { CHUNK_SIZE = 4096 }; //!< records converted per block
+
+  legacy_log_converter_t( void);
+  legacy_log_converter_t( const old_input_data_t * data, size_t count);
+  ~legacy_log_converter_t( void);
+
+  //! read legacy records from this file, @return true on error or a truncated file
+  bool open( const char * path);
+
+  size_t next_block( const observations_type * &block);
+
+private:
+  legacy_log_converter_t( const legacy_log_converter_t &); // not copyable
+  legacy_log_converter_t & operator = ( const legacy_log_converter_t &);
+
+  const old_input_data_t * input;	//!< memory input, 0 if reading from file
+  size_t input_count;
+  FILE * file;
+  old_input_data_t * file_buffer;
+  observations_type * output_buffer;
+};
+
+#endif /* LEGACY_LOG_CONVERTER_H_ */
@@ -0,0 +1,151 @@
+/***********************************************************************//**
+ * @file		replay_configuration.cpp
+ * @brief		host implementation of the EEPROM parameter interface for replays
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include <assert.h>
+#include "system_configuration.h"
+#include "embedded_math.h"
+#include "replay_configuration.h"
+#include "magnetic_induction_report.h"
+
+static thread_local flight_configuration_t default_configuration;
+static thread_local flight_configuration_t * active_configuration = 0;
+
+static flight_configuration_t & current_configuration( void)
+{
+  return active_configuration ? *active_configuration : default_configuration;
+}
+
+flight_configuration_t::flight_configuration_t( void)
+: selector( 0),
+  magnetic_calibration_reports( 0)
+{
+  for( unsigned slot = 0; slot < 2; ++slot)
+    for( unsigned i = 0; i < EEPROM_PARAMETER_ID_END; ++i)
+      {
+	value[slot][i] = 0.0f;
+	available[slot][i] = false;
+      }
+
+  for( const persistent_data_t *parameter = PERSISTENT_DATA; parameter < (PERSISTENT_DATA+PERSISTENT_DATA_ENTRIES); ++parameter )
+    set( parameter->id, parameter->default_value);
+}
+
+void flight_configuration_t::set_slot( EEPROM_PARAMETER_ID id, float new_value, bool slot_B)
+{
+  if( id >= EEPROM_PARAMETER_ID_END)
+    return;
+  value[slot_B][id] = new_value;
+  available[slot_B][id] = true;
+}
+
+bool flight_configuration_t::get_slot( EEPROM_PARAMETER_ID id, float &result, bool slot_B) const
+{
+  if( ( id >= EEPROM_PARAMETER_ID_END) || ! available[slot_B][id])
+    return true; // error
+  result = value[slot_B][id];
+  return false;
+}
+
+configuration_scope_t::configuration_scope_t( flight_configuration_t &configuration)
+: previous( active_configuration)
+{
+  active_configuration = &configuration;
+}
+
+configuration_scope_t::~configuration_scope_t( void)
+{
+  active_configuration = previous;
+}
+
+// host implementation of the persistent data interface
+
+float configuration( EEPROM_PARAMETER_ID id)
+{
+  float value = 0.0f;
+  bool result = current_configuration().get( id, value);
+  assert( result == false);
+  (void)result;
+  return value;
+}
+
+bool read_EEPROM_value( EEPROM_PARAMETER_ID id, float &value)
+{
+  return current_configuration().get( id, value);
+}
+
+bool write_EEPROM_value( EEPROM_PARAMETER_ID id, float value)
+{
+  if( id >= EEPROM_PARAMETER_ID_END)
+    return true; // error
+  current_configuration().set( id, value);
+  return false;
+}
+
+void load_configuration_cache( void)
+{
+  // nothing to do, the flight configuration is kept in RAM anyway
+}
+
+bool write_EEPROM_slot( EEPROM_PARAMETER_ID id, float value, bool slot_B)
+{
+  if( id >= EEPROM_PARAMETER_ID_END)
+    return true; // error
+  current_configuration().set_slot( id, value, slot_B);
+  return false;
+}
+
+bool copy_EEPROM_slot( EEPROM_PARAMETER_ID id, bool to_slot_B, float value_if_missing)
+{
+  float value;
+  if( current_configuration().get_slot( id, value, ! to_slot_B))
+    value = value_if_missing;
+  current_configuration().set_slot( id, value, to_slot_B);
+  return false;
+}
+
+bool write_EEPROM_selector( uint16_t selector)
+{
+  current_configuration().set_selector( selector);
+  return false;
+}
+
+uint16_t read_EEPROM_selector( void)
+{
+  return current_configuration().get_selector();
+}
+
+bool lock_EEPROM( bool)
+{
+  return false; // nothing to lock here
+}
+
+bool EEPROM_initialize( void)
+{
+  return false;
+}
+
+void report_magnetic_calibration_has_changed( magnetic_induction_report_t *, char)
+{
+  current_configuration().report_magnetic_calibration();
+}
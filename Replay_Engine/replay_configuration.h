@@ -0,0 +1,105 @@
+/***********************************************************************//**
+ * @file		replay_configuration.h
+ * @brief		per-flight configuration context for host-side replays
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef REPLAY_CONFIGURATION_H_
+#define REPLAY_CONFIGURATION_H_
+
+#include "persistent_data.h"
+
+/**
+ * @brief per-flight replacement of the EEPROM parameter storage
+ *
+ * On the target configuration() and friends read the EEPROM.
+ * The replay library provides host implementations of this API
+ * that operate on the flight configuration bound to the calling thread.
+ * This way any number of organizer_t instances can run in parallel,
+ * each one seeing its own parameters and calibration data.
+ */
+class flight_configuration_t
+{
+public:
+  flight_configuration_t( void); //!< initialize all parameters with their default values
+
+  //! set a parameter, e.g. sensor tilt or pitot span of the recorded flight
+  void set( EEPROM_PARAMETER_ID id, float value)
+  {
+    set_slot( id, value, EEPROM_uses_slot_B( selector, id));
+  }
+
+  //! @return true on error (parameter unknown)
+  bool get( EEPROM_PARAMETER_ID id, float &value) const
+  {
+    return get_slot( id, value, EEPROM_uses_slot_B( selector, id));
+  }
+
+  //! EEPROM transaction slots, see EEPROM_SLOT_B_BASE
+  void set_slot( EEPROM_PARAMETER_ID id, float value, bool slot_B);
+  bool get_slot( EEPROM_PARAMETER_ID id, float &value, bool slot_B) const;
+
+  void set_selector( uint16_t new_selector)
+  {
+    selector = new_selector;
+  }
+
+  uint16_t get_selector( void) const
+  {
+    return selector;
+  }
+
+  //! count the magnetic calibration reports issued by the AHRS
+  void report_magnetic_calibration( void)
+  {
+    ++magnetic_calibration_reports;
+  }
+
+  unsigned get_magnetic_calibration_reports( void) const
+  {
+    return magnetic_calibration_reports;
+  }
+
+private:
+  float value[2][EEPROM_PARAMETER_ID_END]; //!< slot A, slot B
+  bool available[2][EEPROM_PARAMETER_ID_END];
+  uint16_t selector;
+  unsigned magnetic_calibration_reports;
+};
+
+/**
+ * @brief bind a flight configuration to the calling thread
+ *
+ * All configuration() / EEPROM calls made by this thread during the
+ * lifetime of the scope object are served by the given configuration.
+ * Threads without an active scope use a private default configuration.
+ */
+class configuration_scope_t
+{
+public:
+  configuration_scope_t( flight_configuration_t &configuration);
+  ~configuration_scope_t( void);
+private:
+  configuration_scope_t( const configuration_scope_t &); // not copyable
+  flight_configuration_t * previous;
+};
+
+#endif /* REPLAY_CONFIGURATION_H_ */
@@ -0,0 +1,140 @@
+/***********************************************************************//**
+ * @file		work_stealing_pool.cpp
+ * @brief		thread pool with per-worker task queues and work stealing
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#include "work_stealing_pool.h"
+
+static thread_local const work_stealing_pool_t * worker_pool = 0; //!< pool of the calling worker, 0 if no worker thread
+static thread_local unsigned worker_index; //!< index of the calling worker within worker_pool
+
+work_stealing_pool_t::work_stealing_pool_t( unsigned threads)
+: queued_tasks( 0),
+  unfinished_tasks( 0),
+  next_queue( 0),
+  terminate( false)
+{
+  if( threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if( threads == 0)
+    threads = 1;
+
+  for( unsigned i = 0; i < threads; ++i)
+    queues.emplace_back( new task_queue_t);
+  for( unsigned i = 0; i < threads; ++i)
+    workers.emplace_back( &work_stealing_pool_t::worker_loop, this, i);
+}
+
+work_stealing_pool_t::~work_stealing_pool_t( void)
+{
+  wait_idle();
+    {
+      std::lock_guard<std::mutex> guard( state_lock);
+      terminate = true;
+    }
+  work_available.notify_all();
+  for( std::thread &worker : workers)
+    worker.join();
+}
+
+void work_stealing_pool_t::submit( task_t task)
+{
+  // our workers keep their own follow-up jobs local, others distribute round-robin
+  unsigned target = worker_pool == this
+      ? worker_index
+      : next_queue.fetch_add( 1) % queues.size();
+
+    {
+      std::lock_guard<std::mutex> guard( queues[target]->lock);
+      queues[target]->tasks.push_back( std::move( task));
+    }
+    {
+      std::lock_guard<std::mutex> guard( state_lock);
+      ++queued_tasks;
+      ++unfinished_tasks;
+    }
+  work_available.notify_one();
+}
+
+void work_stealing_pool_t::wait_idle( void)
+{
+  std::unique_lock<std::mutex> guard( state_lock);
+  all_done.wait( guard, [this]{ return unfinished_tasks == 0; });
+}
+
+bool work_stealing_pool_t::take_task( unsigned worker, task_t &task)
+{
+    { // LIFO from our own queue: best cache locality
+      task_queue_t &own = *queues[worker];
+      std::lock_guard<std::mutex> guard( own.lock);
+      if( ! own.tasks.empty())
+	{
+	  task = std::move( own.tasks.back());
+	  own.tasks.pop_back();
+	  return true;
+	}
+    }
+
+  // FIFO from the other queues: steal the oldest and usually biggest job
+  for( unsigned i = 1; i < queues.size(); ++i)
+    {
+      task_queue_t &victim = *queues[ (worker + i) % queues.size()];
+      std::lock_guard<std::mutex> guard( victim.lock);
+      if( ! victim.tasks.empty())
+	{
+	  task = std::move( victim.tasks.front());
+	  victim.tasks.pop_front();
+	  return true;
+	}
+    }
+  return false;
+}
+
+void work_stealing_pool_t::worker_loop( unsigned worker)
+{
+  worker_pool = this;
+  worker_index = worker;
+  task_t task;
+
+  while( true)
+    {
+	{
+	  std::unique_lock<std::mutex> guard( state_lock);
+	  work_available.wait( guard, [this]{ return terminate || queued_tasks > 0; });
+	  if( queued_tasks == 0) // terminate and nothing left to do
+	    return;
+	  --queued_tasks; // we reserve one task, it is present in some queue
+	}
+
+      while( ! take_task( worker, task))
+	std::this_thread::yield(); // task is in transit within submit()
+
+      task();
+      task = nullptr;
+
+	{
+	  std::lock_guard<std::mutex> guard( state_lock);
+	  if( --unfinished_tasks == 0)
+	    all_done.notify_all();
+	}
+    }
+}
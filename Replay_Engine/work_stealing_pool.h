@@ -0,0 +1,87 @@
+/***********************************************************************//**
+ * @file		work_stealing_pool.h
+ * @brief		thread pool with per-worker task queues and work stealing
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief host-side thread pool for coarse-grained jobs like flight replays
+ *
+ * Each worker owns a task queue. It takes work from the back of its own
+ * queue and, if that is empty, steals from the front of the other queues.
+ * Long and short jobs thus get balanced across all cores automatically.
+ */
+class work_stealing_pool_t
+{
+public:
+  typedef std::function<void(void)> task_t;
+
+  //! @param threads number of workers, 0 = one per hardware thread
+  explicit work_stealing_pool_t( unsigned threads = 0);
+  ~work_stealing_pool_t( void);
+
+  //! queue one task, may be called from any thread including the workers
+  void submit( task_t task);
+
+  //! block until all tasks submitted so far have been completed
+  void wait_idle( void);
+
+  unsigned get_thread_count( void) const
+  {
+    return (unsigned)workers.size();
+  }
+
+private:
+  struct task_queue_t
+  {
+    std::mutex lock;
+    std::deque<task_t> tasks;
+  };
+
+  work_stealing_pool_t( const work_stealing_pool_t &); // not copyable
+
+  bool take_task( unsigned worker, task_t &task);
+  void worker_loop( unsigned worker);
+
+  std::vector< std::unique_ptr< task_queue_t> > queues;
+  std::vector< std::thread> workers;
+  std::mutex state_lock;
+  std::condition_variable work_available;
+  std::condition_variable all_done;
+  unsigned queued_tasks;	//!< tasks waiting in any queue, protected by state_lock
+  unsigned unfinished_tasks;	//!< tasks submitted but not yet completed, protected by state_lock
+  std::atomic<unsigned> next_queue;
+  bool terminate;
+};
+
+#endif /* WORK_STEALING_POOL_H_ */
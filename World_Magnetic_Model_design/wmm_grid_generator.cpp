@@ -0,0 +1,233 @@
+/***********************************************************************//**
+ * @file		wmm_grid_generator.cpp
+ * @brief		generate the worldwide declination / inclination grid from WMM.COF
+ * @author		Dr. Klaus Schaefer
+ * @copyright 		Copyright 2024 Dr. Klaus Schaefer. All rights reserved.
+ * @license 		This project is released under the GNU Public License GPL-3.0
+
+    <Larus Flight Sensor Firmware>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ **************************************************************************/
+
+/*
+ * usage: wmm_grid_generator WMM.COF output.cpp [decimal year]
+ *
+ * Evaluates the World Magnetic Model at sea level (WGS-84 ellipsoid)
+ * on the grid defined in earth_induction_grid.h.
+ * Default date: model epoch + 2.5 years (middle of the validity period).
+ * Build-time tool for the host, CMake target "earth_induction_grid".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "earth_induction_grid.h"
+
+#define MAX_DEGREE 12
+
+static double g[MAX_DEGREE+1][MAX_DEGREE+1];
+static double h[MAX_DEGREE+1][MAX_DEGREE+1];
+static double g_dot[MAX_DEGREE+1][MAX_DEGREE+1];
+static double h_dot[MAX_DEGREE+1][MAX_DEGREE+1];
+static double epoch;
+static char model_name[32];
+
+//! read the coefficient file, @return true on error
+static bool read_coefficients( const char * filename)
+{
+  FILE * file = fopen( filename, "r");
+  if( file == 0)
+    return true;
+
+  char line[200];
+  if( fgets( line, sizeof( line), file) == 0
+      || sscanf( line, "%lf %31s", &epoch, model_name) != 2)
+    {
+      fclose( file);
+      return true;
+    }
+
+  while( fgets( line, sizeof( line), file))
+    {
+      int n, m;
+      double gnm, hnm, gnm_dot, hnm_dot;
+      if( sscanf( line, "%d %d %lf %lf %lf %lf", &n, &m, &gnm, &hnm, &gnm_dot, &hnm_dot) != 6)
+	break; // end marker
+      if( n < 1 || n > MAX_DEGREE || m < 0 || m > n)
+	continue;
+      g[n][m] = gnm;
+      h[n][m] = hnm;
+      g_dot[n][m] = gnm_dot;
+      h_dot[n][m] = hnm_dot;
+    }
+  fclose( file);
+  return false;
+}
+
+//! declination and inclination / degrees at sea level, WMM technical report algorithm
+static void evaluate( double latitude, double longitude, double year, double &declination, double &inclination)
+{
+  const double A_WGS84 = 6378.137;
+  const double F_WGS84 = 1.0 / 298.257223563;
+  const double E2 = F_WGS84 * (2.0 - F_WGS84);
+  const double REFERENCE_RADIUS = 6371.2;
+
+  double phi    = latitude  * M_PI / 180.0;
+  double lambda = longitude * M_PI / 180.0;
+
+  // geodetic -> geocentric spherical coordinates
+  double Rc = A_WGS84 / sqrt( 1.0 - E2 * sin( phi) * sin( phi));
+  double p = Rc * cos( phi);
+  double z = Rc * (1.0 - E2) * sin( phi);
+  double r = sqrt( p * p + z * z);
+  double phi_c = asin( z / r);
+
+  // Schmidt semi-normalized associated Legendre functions of cos( colatitude)
+  double x = sin( phi_c); // cos theta
+  double y = cos( phi_c); // sin theta
+  double P[MAX_DEGREE+1][MAX_DEGREE+1] = { { 0.0 } };
+  double dP[MAX_DEGREE+1][MAX_DEGREE+1] = { { 0.0 } }; // d / d theta
+  double S[MAX_DEGREE+1][MAX_DEGREE+1] = { { 0.0 } };
+
+  P[0][0] = 1.0;
+  S[0][0] = 1.0;
+  for( int n = 1; n <= MAX_DEGREE; ++n)
+    {
+      S[n][0] = S[n-1][0] * (2.0 * n - 1.0) / n;
+      for( int m = 1; m <= n; ++m)
+	S[n][m] = S[n][m-1] * sqrt( (n - m + 1.0) * ((m == 1) ? 2.0 : 1.0) / (n + m));
+
+      for( int m = 0; m <= n; ++m)
+	if( m == n)
+	  {
+	    P[n][n]  = y * P[n-1][n-1];
+	    dP[n][n] = y * dP[n-1][n-1] + x * P[n-1][n-1];
+	  }
+	else if( n == 1)
+	  {
+	    P[1][0]  = x * P[0][0];
+	    dP[1][0] = x * dP[0][0] - y * P[0][0];
+	  }
+	else
+	  {
+	    double K = ( (n - 1.0) * (n - 1.0) - m * m) / ( (2.0 * n - 1.0) * (2.0 * n - 3.0));
+	    P[n][m]  = x * P[n-1][m] - K * P[n-2][m];
+	    dP[n][m] = x * dP[n-1][m] - y * P[n-1][m] - K * dP[n-2][m];
+	  }
+    }
+
+  double dt = year - epoch;
+  double B_r = 0.0, B_theta = 0.0, B_phi = 0.0;
+  double ratio = REFERENCE_RADIUS / r;
+  double power = ratio * ratio;
+
+  for( int n = 1; n <= MAX_DEGREE; ++n)
+    {
+      power *= ratio; // (a/r)^(n+2)
+      for( int m = 0; m <= n; ++m)
+	{
+	  double gnm = g[n][m] + dt * g_dot[n][m];
+	  double hnm = h[n][m] + dt * h_dot[n][m];
+	  double cos_m = cos( m * lambda);
+	  double sin_m = sin( m * lambda);
+	  double Pnm  = S[n][m] * P[n][m];
+	  double dPnm = S[n][m] * dP[n][m];
+
+	  B_r     += power * (n + 1) * ( gnm * cos_m + hnm * sin_m) * Pnm;
+	  B_theta -= power * ( gnm * cos_m + hnm * sin_m) * dPnm;
+	  B_phi   += power * m * ( gnm * sin_m - hnm * cos_m) * Pnm;
+	}
+    }
+  B_phi /= y;
+
+  // spherical -> ellipsoidal north east down
+  double X_c = -B_theta;
+  double Z_c = -B_r;
+  double psi = phi_c - phi;
+  double X = X_c * cos( psi) - Z_c * sin( psi);
+  double Y = B_phi;
+  double Z = X_c * sin( psi) + Z_c * cos( psi);
+
+  declination = atan2( Y, X) * 180.0 / M_PI;
+  inclination = atan2( Z, sqrt( X * X + Y * Y)) * 180.0 / M_PI;
+}
+
+static int16_t to_grid( double degrees)
+{
+  return (int16_t)lround( degrees / EARTH_INDUCTION_GRID_LSB);
+}
+
+int main( int argc, char ** argv)
+{
+  if( argc < 3)
+    {
+      fprintf( stderr, "usage: %s WMM.COF output.cpp [decimal year]\n", argv[0]);
+      return 1;
+    }
+  if( read_coefficients( argv[1]))
+    {
+      fprintf( stderr, "%s: can not read coefficients\n", argv[1]);
+      return 1;
+    }
+  double year = argc > 3 ? atof( argv[3]) : epoch + 2.5;
+
+  static int16_t declination[EARTH_INDUCTION_GRID_ROWS][EARTH_INDUCTION_GRID_COLUMNS];
+  static int16_t inclination[EARTH_INDUCTION_GRID_ROWS][EARTH_INDUCTION_GRID_COLUMNS];
+
+  for( unsigned row = 0; row < EARTH_INDUCTION_GRID_ROWS; ++row)
+    for( unsigned column = 0; column < EARTH_INDUCTION_GRID_COLUMNS; ++column)
+      {
+	double latitude  = -90.0  + row    * EARTH_INDUCTION_GRID_STEP;
+	double longitude = -180.0 + column * EARTH_INDUCTION_GRID_STEP;
+	if( latitude > 89.9) // the poles are singular, use a point nearby
+	  latitude = 89.9;
+	if( latitude < -89.9)
+	  latitude = -89.9;
+	double D, I;
+	evaluate( latitude, longitude, year, D, I);
+	declination[row][column] = to_grid( D);
+	inclination[row][column] = to_grid( I);
+      }
+
+  FILE * out = fopen( argv[2], "w");
+  if( out == 0)
+    {
+      fprintf( stderr, "%s: can not write\n", argv[2]);
+      return 1;
+    }
+
+  fprintf( out, "// generated by wmm_grid_generator from %s for %.1f, do not edit\n\n", model_name, year);
+  fprintf( out, "#include \"earth_induction_grid.h\"\n\n");
+
+  const char * name[2] = { "declination", "inclination"};
+  int16_t (*grid[2])[EARTH_INDUCTION_GRID_COLUMNS] = { declination, inclination};
+  for( unsigned k = 0; k < 2; ++k)
+    {
+      fprintf( out, "ROM int16_t earth_induction_grid_t::%s[EARTH_INDUCTION_GRID_ROWS][EARTH_INDUCTION_GRID_COLUMNS] =\n{\n", name[k]);
+      for( unsigned row = 0; row < EARTH_INDUCTION_GRID_ROWS; ++row)
+	{
+	  fprintf( out, "  { // %+.0f\n   ", -90.0 + row * EARTH_INDUCTION_GRID_STEP);
+	  for( unsigned column = 0; column < EARTH_INDUCTION_GRID_COLUMNS; ++column)
+	    fprintf( out, " %6d,%s", grid[k][row][column],
+		     (column % 12 == 11 && column + 1 < EARTH_INDUCTION_GRID_COLUMNS) ? "\n   " : "");
+	  fprintf( out, "\n  },\n");
+	}
+      fprintf( out, "};\n\n");
+    }
+  fclose( out);
+  return 0;
+}